@@ -56,6 +56,25 @@ BL31_SOURCES		+=	services/std_svc/sdei/sdei_dispatch.S	\
 				services/std_svc/sdei/sdei_intr_mgmt.c	\
 				services/std_svc/sdei/sdei_main.c	\
 				services/std_svc/sdei/sdei_state.c
+ifeq (${SDEI_LATENCY_STATS},1)
+ifeq (${ENABLE_PMF},0)
+  $(error ENABLE_PMF must be 1 for SDEI_LATENCY_STATS)
+endif
+BL31_SOURCES		+=	services/std_svc/sdei/sdei_latency.c
+LATENCY_HIST_NEEDED	:=	1
+endif
+else ifeq (${SDEI_LATENCY_STATS},1)
+  $(error SDEI_SUPPORT must be 1 for SDEI_LATENCY_STATS)
+endif
+
+ifeq (${LATENCY_HIST_NEEDED},1)
+BL31_SOURCES		+=	lib/latency_hist/latency_hist.c
+endif
+
+ifeq (${EL3_TRACE},1)
+BL31_SOURCES		+=	lib/el3_trace/el3_trace.c
+else ifeq (${EL3_TRACE_NS_READ},1)
+  $(error EL3_TRACE must be 1 for EL3_TRACE_NS_READ)
 endif
 
 ifeq (${ENABLE_SPE_FOR_LOWER_ELS},1)
@@ -71,6 +90,13 @@ ifeq (${ENABLE_SVE_FOR_NS},1)
 BL31_SOURCES		+=	lib/extensions/sve/sve.c
 endif
 
+ifeq (${CTX_LAZY_FPREGS},1)
+BL31_SOURCES		+=	lib/el3_runtime/aarch64/lazy_fpregs.c
+ifeq (${ENABLE_SVE_FOR_NS},1)
+BL31_SOURCES		+=	lib/extensions/sve/sve_helpers.S
+endif
+endif
+
 ifeq (${ENABLE_MPAM_FOR_LOWER_ELS},1)
 BL31_SOURCES		+=	lib/extensions/mpam/mpam.c
 endif
@@ -90,8 +116,14 @@ endif
 
 $(eval $(call assert_boolean,CRASH_REPORTING))
 $(eval $(call assert_boolean,EL3_EXCEPTION_HANDLING))
+$(eval $(call assert_boolean,EL3_TRACE))
+$(eval $(call assert_boolean,EL3_TRACE_NS_READ))
 $(eval $(call assert_boolean,SDEI_SUPPORT))
+$(eval $(call assert_boolean,SDEI_LATENCY_STATS))
 
 $(eval $(call add_define,CRASH_REPORTING))
 $(eval $(call add_define,EL3_EXCEPTION_HANDLING))
+$(eval $(call add_define,EL3_TRACE))
+$(eval $(call add_define,EL3_TRACE_NS_READ))
 $(eval $(call add_define,SDEI_SUPPORT))
+$(eval $(call add_define,SDEI_LATENCY_STATS))
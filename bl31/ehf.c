@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -11,11 +11,14 @@
 #include <assert.h>
 #include <stdbool.h>
 
+#include <platform_def.h>
+
 #include <bl31/ehf.h>
 #include <bl31/interrupt_mgmt.h>
 #include <context.h>
 #include <common/debug.h>
 #include <drivers/arm/gic_common.h>
+#include <lib/cassert.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/el3_runtime/cpu_data.h>
 #include <lib/el3_runtime/pubsub_events.h>
@@ -50,6 +53,38 @@
 /* To be defined by the platform */
 extern const ehf_priorities_t exception_data;
 
+/*
+ * Handlers registered for individual interrupts, which take precedence over the
+ * handler of the priority level the interrupt belongs to.
+ *
+ * Interrupt IDs are looked up in a two-level table: the first level has an
+ * entry for each block of EHF_INTR_BLOCK_SIZE consecutive IDs, holding the
+ * index of the block in ehf_intr_blocks plus one, or 0 if no interrupt in the
+ * block has a handler. Block entries hold the index of the handler descriptor
+ * in ehf_intr_descs plus one, or 0. Memory is thus only used for the blocks of
+ * IDs that actually have handlers, even for sparse sets of SPIs.
+ */
+#define EHF_INTR_BLOCK_SHIFT	U(5)
+#define EHF_INTR_BLOCK_SIZE	(U(1) << EHF_INTR_BLOCK_SHIFT)
+#define EHF_MAX_INTR_ID		MAX_SPI_ID
+#define EHF_INTR_NUM_BLOCKS	((EHF_MAX_INTR_ID >> EHF_INTR_BLOCK_SHIFT) + U(1))
+
+CASSERT(PLAT_EHF_MAX_INTR_HANDLERS < U(256), assert_ehf_intr_handlers_fit_u8);
+CASSERT(PLAT_EHF_MAX_INTR_BLOCKS < U(256), assert_ehf_intr_blocks_fit_u8);
+
+typedef struct ehf_intr_desc {
+	ehf_intr_handler_t handler;
+	void *arg;
+} ehf_intr_desc_t;
+
+static ehf_intr_desc_t ehf_intr_descs[PLAT_EHF_MAX_INTR_HANDLERS];
+static unsigned int ehf_num_intr_descs;
+
+static uint8_t ehf_intr_blocks[PLAT_EHF_MAX_INTR_BLOCKS][EHF_INTR_BLOCK_SIZE];
+static unsigned int ehf_num_intr_blocks;
+
+static uint8_t ehf_intr_index[EHF_INTR_NUM_BLOCKS];
+
 /* Translate priority to the index in the priority array */
 static unsigned int pri_to_idx(unsigned int priority)
 {
@@ -62,6 +97,28 @@ static unsigned int pri_to_idx(unsigned int priority)
 	return idx;
 }
 
+/*
+ * Return the handler descriptor registered for an interrupt, or NULL if there
+ * isn't any.
+ */
+static const ehf_intr_desc_t *get_intr_desc(unsigned int intr)
+{
+	unsigned int blk, desc;
+
+	if (intr > EHF_MAX_INTR_ID)
+		return NULL;
+
+	blk = ehf_intr_index[intr >> EHF_INTR_BLOCK_SHIFT];
+	if (blk == 0U)
+		return NULL;
+
+	desc = ehf_intr_blocks[blk - 1U][intr & (EHF_INTR_BLOCK_SIZE - 1U)];
+	if (desc == 0U)
+		return NULL;
+
+	return &ehf_intr_descs[desc - 1U];
+}
+
 /* Return whether there are outstanding priority activation */
 static bool has_valid_pri_activations(pe_exc_data_t *pe_data)
 {
@@ -397,6 +454,7 @@ static uint64_t ehf_el3_interrupt_handler(uint32_t id, uint32_t flags,
 	uint32_t intr_raw;
 	unsigned int intr, pri, idx;
 	ehf_handler_t handler;
+	const ehf_intr_desc_t *intr_desc;
 
 	/*
 	 * Top-level interrupt type handler from Interrupt Management Framework
@@ -432,6 +490,17 @@ static uint64_t ehf_el3_interrupt_handler(uint32_t id, uint32_t flags,
 	/* Validate priority */
 	assert(pri == IDX_TO_PRI(idx));
 
+	/*
+	 * A handler registered for this very interrupt takes precedence over
+	 * the handler of its priority level.
+	 */
+	intr_desc = get_intr_desc(intr);
+	if (intr_desc != NULL) {
+		ret = intr_desc->handler(intr_raw, flags, handle, cookie,
+				intr_desc->arg);
+		return (uint64_t) ret;
+	}
+
 	handler = (ehf_handler_t) RAW_HANDLER(
 			exception_data.ehf_priorities[idx].ehf_handler);
 	if (handler == NULL) {
@@ -522,5 +591,55 @@ void ehf_register_priority_handler(unsigned int pri, ehf_handler_t handler)
 	EHF_LOG("register pri=0x%x handler=%p\n", pri, handler);
 }
 
+/*
+ * Register a handler for an individual EL3 interrupt, which is then called
+ * instead of the handler of the interrupt's priority level. 'arg' is passed to
+ * the handler as is. Only one handler can be registered for an interrupt.
+ */
+void ehf_register_interrupt_handler(unsigned int intr,
+		ehf_intr_handler_t handler, void *arg)
+{
+	unsigned int l1 = intr >> EHF_INTR_BLOCK_SHIFT;
+	uint8_t *blk;
+
+	assert(handler != NULL);
+
+	if (intr > EHF_MAX_INTR_ID) {
+		ERROR("Can't register handler for interrupt %u\n", intr);
+		panic();
+	}
+
+	if (get_intr_desc(intr) != NULL) {
+		ERROR("Handler already registered for interrupt %u\n", intr);
+		panic();
+	}
+
+	if (ehf_num_intr_descs == PLAT_EHF_MAX_INTR_HANDLERS) {
+		ERROR("Too many EL3 interrupt handlers, increase "
+		      "PLAT_EHF_MAX_INTR_HANDLERS\n");
+		panic();
+	}
+
+	/* Allocate a block for this range of interrupt IDs if needed */
+	if (ehf_intr_index[l1] == 0U) {
+		if (ehf_num_intr_blocks == PLAT_EHF_MAX_INTR_BLOCKS) {
+			ERROR("Too many EL3 interrupt handler blocks, increase "
+			      "PLAT_EHF_MAX_INTR_BLOCKS\n");
+			panic();
+		}
+
+		ehf_intr_index[l1] = (uint8_t) ++ehf_num_intr_blocks;
+	}
+
+	ehf_intr_descs[ehf_num_intr_descs].handler = handler;
+	ehf_intr_descs[ehf_num_intr_descs].arg = arg;
+	ehf_num_intr_descs++;
+
+	blk = ehf_intr_blocks[ehf_intr_index[l1] - 1U];
+	blk[intr & (EHF_INTR_BLOCK_SIZE - 1U)] = (uint8_t) ehf_num_intr_descs;
+
+	EHF_LOG("register intr=%u handler=%p\n", intr, handler);
+}
+
 SUBSCRIBE_TO_EVENT(cm_entering_normal_world, ehf_entering_normal_world);
 SUBSCRIBE_TO_EVENT(cm_exited_normal_world, ehf_exited_normal_world);
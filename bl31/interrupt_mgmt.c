@@ -10,6 +10,7 @@
 #include <common/bl_common.h>
 #include <bl31/interrupt_mgmt.h>
 #include <lib/el3_runtime/context_mgmt.h>
+#include <lib/el3_trace.h>
 #include <plat/common/platform.h>
 
 /*******************************************************************************
@@ -222,6 +223,9 @@ interrupt_type_handler_t get_interrupt_type_handler(uint32_t type)
 	if (validate_interrupt_type(type) != 0)
 		return NULL;
 
+	EL3_TRACE_EVENT(EL3_TRACE_EV_INTR, type,
+			plat_ic_get_pending_interrupt_id());
+
 	return intr_type_descs[type].handler;
 }
 
@@ -1,11 +1,12 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <stdarg.h>
 #include <assert.h>
+#include <stdint.h>
 #include <stdio.h>
 
 #include <common/debug.h>
@@ -49,6 +50,125 @@ void tf_log(const char *fmt, ...)
 	va_end(args);
 }
 
+#if LOG_TOKENIZED
+/*
+ * Identifier of the image in the tokenized log messages, so that the host tool
+ * knows in which ELF file to look the tokens up.
+ */
+#if defined(IMAGE_BL1)
+#define TF_LOG_IMAGE_ID		1
+#elif defined(IMAGE_BL2)
+#define TF_LOG_IMAGE_ID		2
+#elif defined(IMAGE_BL2U)
+#define TF_LOG_IMAGE_ID		21
+#elif defined(IMAGE_BL31)
+#define TF_LOG_IMAGE_ID		31
+#elif defined(IMAGE_BL32)
+#define TF_LOG_IMAGE_ID		32
+#else
+#define TF_LOG_IMAGE_ID		0
+#endif
+
+/* Maximum size of the binary encoding of a message, before base64 encoding */
+#define TF_LOG_MAX_PAYLOAD	128U
+
+static size_t tf_log_put_varint(uint8_t *buf, size_t len, uint64_t val)
+{
+	do {
+		if (len == TF_LOG_MAX_PAYLOAD)
+			return len;
+		buf[len] = (uint8_t)(val & 0x7fU);
+		val >>= 7;
+		if (val != 0U)
+			buf[len] |= 0x80U;
+		len++;
+	} while (val != 0U);
+
+	return len;
+}
+
+static void tf_log_put_base64(const uint8_t *buf, size_t len)
+{
+	static const char b64[] =
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+		"abcdefghijklmnopqrstuvwxyz"
+		"0123456789+/";
+	uint32_t val;
+	size_t i;
+
+	for (i = 0U; i < len; i += 3U) {
+		val = (uint32_t)buf[i] << 16;
+		if ((i + 1U) < len)
+			val |= (uint32_t)buf[i + 1U] << 8;
+		if ((i + 2U) < len)
+			val |= buf[i + 2U];
+
+		(void)putchar(b64[(val >> 18) & 0x3fU]);
+		(void)putchar(b64[(val >> 12) & 0x3fU]);
+		(void)putchar(((i + 1U) < len) ? b64[(val >> 6) & 0x3fU] : '=');
+		(void)putchar(((i + 2U) < len) ? b64[val & 0x3fU] : '=');
+	}
+}
+
+/*
+ * The log function invoked by the log macros of debug.h when LOG_TOKENIZED is
+ * set, instead of tf_log(). Rather than formatting the message, it outputs a
+ * line "$<image id>:<base64 payload>", where the payload holds the token and
+ * then the arguments, all as LEB128 varints except for strings, which are
+ * copied with their terminating NUL. Arguments which don't fit in the payload
+ * are dropped, and the host tool prints them as missing.
+ */
+void tf_log_tokenized(unsigned int log_level, uintptr_t token,
+		      unsigned int types, unsigned int nargs, ...)
+{
+	uint8_t buf[TF_LOG_MAX_PAYLOAD];
+	size_t len;
+	const char *str;
+	unsigned int i;
+	va_list args;
+
+	assert((log_level > 0U) && (log_level <= LOG_LEVEL_VERBOSE));
+	assert(nargs <= TF_LOG_TOKENIZED_MAX_ARGS);
+
+	if (log_level > max_log_level)
+		return;
+
+	len = tf_log_put_varint(buf, 0U, token);
+
+	va_start(args, nargs);
+	for (i = 0U; i < nargs; i++) {
+		switch ((types >> (i * TF_LOG_ARG_TYPE_BITS)) &
+			TF_LOG_ARG_TYPE_MASK) {
+		case TF_LOG_ARG_64:
+			len = tf_log_put_varint(buf, len,
+						va_arg(args, uint64_t));
+			break;
+		case TF_LOG_ARG_STR:
+			str = va_arg(args, const char *);
+			if (str == NULL)
+				str = "(null)";
+			while ((*str != '\0') &&
+			       (len < (TF_LOG_MAX_PAYLOAD - 1U))) {
+				buf[len++] = (uint8_t)*str;
+				str++;
+			}
+			if (len < TF_LOG_MAX_PAYLOAD)
+				buf[len++] = 0U;
+			break;
+		default:
+			len = tf_log_put_varint(buf, len,
+						va_arg(args, unsigned int));
+			break;
+		}
+	}
+	va_end(args);
+
+	(void)printf("$%d:", TF_LOG_IMAGE_ID);
+	tf_log_put_base64(buf, len);
+	(void)putchar('\n');
+}
+#endif /* LOG_TOKENIZED */
+
 /*
  * The helper function to set the log level dynamically by platform. The
  * maximum log level is determined by `LOG_LEVEL` build flag at compile time
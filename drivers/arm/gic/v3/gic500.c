@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -20,3 +20,10 @@ void gicv3_distif_post_restore(unsigned int proc_num)
 	arm_gicv3_distif_post_restore(proc_num);
 }
 
+/*
+ * The GIC-500 Distributor resets the SPI configuration registers to 0.
+ */
+bool gicv3_distif_resets_to_zero(void)
+{
+	return true;
+}
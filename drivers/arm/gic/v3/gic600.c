@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -125,3 +125,11 @@ void gicv3_rdistif_on(unsigned int proc_num)
 	/* Power redistributor on */
 	gic600_pwr_on(gicr_base);
 }
+
+/*
+ * The GIC-600 Distributor resets the SPI configuration registers to 0.
+ */
+bool gicv3_distif_resets_to_zero(void)
+{
+	return true;
+}
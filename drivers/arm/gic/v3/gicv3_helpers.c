@@ -1,10 +1,12 @@
 /*
- * Copyright (c) 2015-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
+#include <stdbool.h>
+#include <string.h>
 
 #include <arch.h>
 #include <arch_helpers.h>
@@ -278,18 +280,55 @@ void gicr_set_icfgr1(uintptr_t base, unsigned int id, unsigned int cfg)
  *****************************************************************************/
 void gicv3_rdistif_mark_core_awake(uintptr_t gicr_base)
 {
+	gicv3_rdistif_kick_awake(gicr_base);
+
+	/* Wait till the WAKER_CA_BIT changes to 0 */
+	while ((gicr_read_waker(gicr_base) & WAKER_CA_BIT) != 0U)
+		;
+}
+
+/******************************************************************************
+ * This function marks the core as awake in the re-distributor without waiting
+ * for the interface to become active. It does nothing if the core is already
+ * marked as awake, e.g. by the primary CPU at cold boot.
+ *****************************************************************************/
+void gicv3_rdistif_kick_awake(uintptr_t gicr_base)
+{
+	unsigned int waker = gicr_read_waker(gicr_base);
+
+	if ((waker & WAKER_PS_BIT) == 0U)
+		return;
+
 	/*
 	 * The WAKER_PS_BIT should be changed to 0
 	 * only when WAKER_CA_BIT is 1.
 	 */
-	assert((gicr_read_waker(gicr_base) & WAKER_CA_BIT) != 0U);
+	assert((waker & WAKER_CA_BIT) != 0U);
 
 	/* Mark the connected core as awake */
-	gicr_write_waker(gicr_base, gicr_read_waker(gicr_base) & ~WAKER_PS_BIT);
+	gicr_write_waker(gicr_base, waker & ~WAKER_PS_BIT);
+}
 
-	/* Wait till the WAKER_CA_BIT changes to 0 */
-	while ((gicr_read_waker(gicr_base) & WAKER_CA_BIT) != 0U)
-		;
+/******************************************************************************
+ * This function waits for the re-distributors of all the cores to become
+ * active, once they have been marked as awake with gicv3_rdistif_kick_awake().
+ * Polling them together means waiting for the slowest of them, rather than
+ * for the sum of their wake-up latencies.
+ *****************************************************************************/
+void gicv3_rdistif_wait_all_awake(const uintptr_t *rdistif_base_addrs,
+				  unsigned int rdistif_num)
+{
+	unsigned int i;
+
+	for (i = 0U; i < rdistif_num; i++) {
+		if (rdistif_base_addrs[i] == 0U)
+			continue;
+
+		/* Wait till the WAKER_CA_BIT changes to 0 */
+		while ((gicr_read_waker(rdistif_base_addrs[i]) &
+				WAKER_CA_BIT) != 0U)
+			;
+	}
 }
 
 
@@ -350,11 +389,12 @@ void gicv3_rdistif_base_addrs_probe(uintptr_t *rdistif_base_addrs,
 }
 
 /*******************************************************************************
- * Helper function to configure the default attributes of SPIs.
+ * Helper function to configure the default attributes of SPIs, and of ESPIs if
+ * the Distributor implements them.
  ******************************************************************************/
 void gicv3_spis_config_defaults(uintptr_t gicd_base)
 {
-	unsigned int index, num_ints;
+	unsigned int index, num_ints, max_espi;
 
 	num_ints = gicd_read_typer(gicd_base);
 	num_ints &= TYPER_IT_LINES_NO_MASK;
@@ -379,71 +419,202 @@ void gicv3_spis_config_defaults(uintptr_t gicd_base)
 	 */
 	for (index = MIN_SPI_ID; index < num_ints; index += 16U)
 		gicd_write_icfgr(gicd_base, index, 0U);
+
+	/* Give the ESPIs the same defaults */
+	max_espi = MIN_ESPI_ID + gicd_get_num_espis(gicd_base);
+
+	for (index = MIN_ESPI_ID; index < max_espi; index += 32U)
+		GICD_CALL(gicd_write_igroupr, IGROUPR, gicd_base, index, ~0U);
+
+	for (index = MIN_ESPI_ID; index < max_espi; index += 4U)
+		GICD_CALL(gicd_write_ipriorityr, IPRIORITYR, gicd_base, index,
+			  GICD_IPRIORITYR_DEF_VAL);
+
+	for (index = MIN_ESPI_ID; index < max_espi; index += 16U)
+		GICD_CALL(gicd_write_icfgr, ICFGR, gicd_base, index, 0U);
 }
 
-/*******************************************************************************
- * Helper function to configure properties of secure SPIs
- ******************************************************************************/
-unsigned int gicv3_secure_spis_config_props(uintptr_t gicd_base,
+/*
+ * Configuration of the secure interrupts within a block of 32 consecutive
+ * interrupt IDs, as masks of the bits to program in the registers that hold a
+ * bit or a 2-bit field for each interrupt. This lets the configuration of a
+ * block be written with one access to each of these registers, rather than a
+ * read-modify-write for every interrupt.
+ */
+typedef struct gicv3_intr_block {
+	/* Secure interrupts, to clear in IGROUPR and set in ISENABLER */
+	uint32_t secure;
+
+	/* Group 1 Secure interrupts, to set in IGRPMODR */
+	uint32_t g1s;
+
+	/* Fields to update in the two ICFGR of the block, and their values */
+	uint32_t cfg_mask[2];
+	uint32_t cfg[2];
+} gicv3_intr_block_t;
+
+#define GICV3_INTR_BLOCK_MASK	((1U << IGROUPR_SHIFT) - 1U)
+
+/*
+ * Accumulate the properties of the interrupts in the block starting at
+ * 'block_id' into 'blk'. Returns the GICD_CTLR group enables the interrupts
+ * require.
+ */
+static unsigned int gicv3_intr_block_props(unsigned int block_id,
 		const interrupt_prop_t *interrupt_props,
-		unsigned int interrupt_props_num)
+		unsigned int interrupt_props_num,
+		gicv3_intr_block_t *blk)
 {
-	unsigned int i;
+	unsigned int i, bit, shift;
 	const interrupt_prop_t *current_prop;
-	unsigned long long gic_affinity_val;
 	unsigned int ctlr_enable = 0U;
 
-	/* Make sure there's a valid property array */
-	if (interrupt_props_num > 0U)
-		assert(interrupt_props != NULL);
+	(void)memset(blk, 0, sizeof(*blk));
 
 	for (i = 0U; i < interrupt_props_num; i++) {
 		current_prop = &interrupt_props[i];
 
-		if (current_prop->intr_num < MIN_SPI_ID)
+		if ((current_prop->intr_num & ~GICV3_INTR_BLOCK_MASK) !=
+				block_id)
 			continue;
 
-		/* Configure this interrupt as a secure interrupt */
-		gicd_clr_igroupr(gicd_base, current_prop->intr_num);
+		bit = current_prop->intr_num & GICV3_INTR_BLOCK_MASK;
+		blk->secure |= BIT_32(bit);
 
 		/* Configure this interrupt as G0 or a G1S interrupt */
 		assert((current_prop->intr_grp == INTR_GROUP0) ||
 				(current_prop->intr_grp == INTR_GROUP1S));
 		if (current_prop->intr_grp == INTR_GROUP1S) {
-			gicd_set_igrpmodr(gicd_base, current_prop->intr_num);
+			blk->g1s |= BIT_32(bit);
 			ctlr_enable |= CTLR_ENABLE_G1S_BIT;
 		} else {
-			gicd_clr_igrpmodr(gicd_base, current_prop->intr_num);
 			ctlr_enable |= CTLR_ENABLE_G0_BIT;
 		}
 
-		/* Set interrupt configuration */
-		gicd_set_icfgr(gicd_base, current_prop->intr_num,
-				current_prop->intr_cfg);
+		/* Interrupt configuration is a 2-bit field */
+		shift = (bit & ((1U << ICFGR_SHIFT) - 1U)) << 1U;
+		blk->cfg_mask[bit >> ICFGR_SHIFT] |= GIC_CFG_MASK << shift;
+		blk->cfg[bit >> ICFGR_SHIFT] |=
+			(current_prop->intr_cfg & GIC_CFG_MASK) << shift;
+	}
+
+	return ctlr_enable;
+}
+
+/*
+ * Return whether an interrupt before the 'idx'th one in the property array
+ * belongs to the same block, in which case the block has already been
+ * configured.
+ */
+static bool gicv3_intr_block_done(const interrupt_prop_t *interrupt_props,
+		unsigned int idx)
+{
+	unsigned int i;
+	unsigned int block_id = interrupt_props[idx].intr_num &
+				~GICV3_INTR_BLOCK_MASK;
+
+	for (i = 0U; i < idx; i++) {
+		if ((interrupt_props[i].intr_num & ~GICV3_INTR_BLOCK_MASK) ==
+				block_id)
+			return true;
+	}
+
+	return false;
+}
+
+/*******************************************************************************
+ * Helper function to configure properties of secure SPIs and ESPIs. The
+ * priority and routing of each interrupt are programmed first. The registers
+ * holding a bit or field for each interrupt are then written once for each
+ * block of 32 interrupts containing secure SPIs, which also enables them.
+ ******************************************************************************/
+unsigned int gicv3_secure_spis_config_props(uintptr_t gicd_base,
+		const interrupt_prop_t *interrupt_props,
+		unsigned int interrupt_props_num)
+{
+	unsigned int i, k, block_id;
+	const interrupt_prop_t *current_prop;
+	unsigned long long gic_affinity_val;
+	gicv3_intr_block_t blk;
+	uint32_t reg_val;
+	unsigned int ctlr_enable = 0U;
+
+	/* Make sure there's a valid property array */
+	if (interrupt_props_num > 0U)
+		assert(interrupt_props != NULL);
+
+	/* Target SPIs to the primary CPU */
+	gic_affinity_val = gicd_irouter_val_from_mpidr(read_mpidr(), 0U);
+
+	for (i = 0U; i < interrupt_props_num; i++) {
+		current_prop = &interrupt_props[i];
+
+		if (IS_RDIST_INTR(current_prop->intr_num))
+			continue;
+
+		assert(IS_VALID_INTR(current_prop->intr_num));
 
 		/* Set the priority of this interrupt */
-		gicd_set_ipriorityr(gicd_base, current_prop->intr_num,
-				current_prop->intr_pri);
+		GICD_CALL(gicd_set_ipriorityr, IPRIORITYR, gicd_base,
+			  current_prop->intr_num, current_prop->intr_pri);
 
-		/* Target SPIs to the primary CPU */
-		gic_affinity_val =
-			gicd_irouter_val_from_mpidr(read_mpidr(), 0U);
 		gicd_write_irouter(gicd_base, current_prop->intr_num,
 				gic_affinity_val);
+	}
+
+	for (i = 0U; i < interrupt_props_num; i++) {
+		current_prop = &interrupt_props[i];
 
-		/* Enable this interrupt */
-		gicd_set_isenabler(gicd_base, current_prop->intr_num);
+		if (IS_RDIST_INTR(current_prop->intr_num) ||
+				gicv3_intr_block_done(interrupt_props, i))
+			continue;
+
+		block_id = current_prop->intr_num & ~GICV3_INTR_BLOCK_MASK;
+		ctlr_enable |= gicv3_intr_block_props(block_id,
+				interrupt_props, interrupt_props_num, &blk);
+
+		/* Configure the interrupts as secure, G0 or G1S */
+		reg_val = GICD_CALL(gicd_read_igroupr, IGROUPR, gicd_base,
+				    block_id);
+		GICD_CALL(gicd_write_igroupr, IGROUPR, gicd_base, block_id,
+			  reg_val & ~blk.secure);
+
+		reg_val = GICD_CALL(gicd_read_igrpmodr, IGRPMODR, gicd_base,
+				    block_id);
+		reg_val &= ~blk.secure;
+		GICD_CALL(gicd_write_igrpmodr, IGRPMODR, gicd_base, block_id,
+			  reg_val | blk.g1s);
+
+		/* Set interrupt configuration */
+		for (k = 0U; k < 2U; k++) {
+			if (blk.cfg_mask[k] == 0U)
+				continue;
+
+			reg_val = GICD_CALL(gicd_read_icfgr, ICFGR, gicd_base,
+					block_id + (k << ICFGR_SHIFT));
+			reg_val &= ~blk.cfg_mask[k];
+			GICD_CALL(gicd_write_icfgr, ICFGR, gicd_base,
+				  block_id + (k << ICFGR_SHIFT),
+				  reg_val | blk.cfg[k]);
+		}
+
+		/* Enable these interrupts */
+		GICD_CALL(gicd_write_isenabler, ISENABLER, gicd_base, block_id,
+			  blk.secure);
 	}
 
 	return ctlr_enable;
 }
 
 /*******************************************************************************
- * Helper function to configure the default attributes of SPIs.
+ * Helper function to configure the default attributes of SGIs and PPIs, and of
+ * EPPIs if the Redistributor implements them.
  ******************************************************************************/
 void gicv3_ppi_sgi_config_defaults(uintptr_t gicr_base)
 {
-	unsigned int index;
+	unsigned int index, max_eppi;
+
+	max_eppi = MIN_EPPI_ID + gicr_get_num_eppis(gicr_base);
 
 	/*
 	 * Disable all SGIs (imp. def.)/PPIs before configuring them. This is a
@@ -451,10 +622,14 @@ void gicv3_ppi_sgi_config_defaults(uintptr_t gicr_base)
 	 * GICD_CTLR
 	 */
 	gicr_write_icenabler0(gicr_base, ~0U);
+	for (index = MIN_EPPI_ID; index < max_eppi; index += 32U)
+		gicr_write_icenabler0(GICR_BIT_REG_BASE(gicr_base, index), ~0U);
 	gicr_wait_for_pending_write(gicr_base);
 
 	/* Treat all SGIs/PPIs as G1NS by default. */
 	gicr_write_igroupr0(gicr_base, ~0U);
+	for (index = MIN_EPPI_ID; index < max_eppi; index += 32U)
+		gicr_write_igroupr0(GICR_BIT_REG_BASE(gicr_base, index), ~0U);
 
 	/* Setup the default PPI/SGI priorities doing four at a time */
 	for (index = 0U; index < MIN_SPI_ID; index += 4U)
@@ -462,19 +637,32 @@ void gicv3_ppi_sgi_config_defaults(uintptr_t gicr_base)
 				      index,
 				      GICD_IPRIORITYR_DEF_VAL);
 
+	for (index = MIN_EPPI_ID; index < max_eppi; index += 4U)
+		gicr_write_ipriorityr(gicr_base, gicr_intr_pos(index),
+				      GICD_IPRIORITYR_DEF_VAL);
+
 	/* Configure all PPIs as level triggered by default */
 	gicr_write_icfgr1(gicr_base, 0U);
+	for (index = MIN_EPPI_ID; index < max_eppi; index += 16U)
+		gicr_write_icfgr0(gicr_base +
+				  ((gicr_intr_pos(index) >> ICFGR_SHIFT) << 2),
+				  0U);
 }
 
 /*******************************************************************************
- * Helper function to configure properties of secure G0 and G1S PPIs and SGIs.
+ * Helper function to configure properties of secure G0 and G1S PPIs and SGIs,
+ * and EPPIs. The registers holding a bit or field for each interrupt are
+ * written once for each block of 32 interrupts: the SGIs and PPIs, then each
+ * block of EPPIs the Redistributor implements.
  ******************************************************************************/
 unsigned int gicv3_secure_ppi_sgi_config_props(uintptr_t gicr_base,
 		const interrupt_prop_t *interrupt_props,
 		unsigned int interrupt_props_num)
 {
-	unsigned int i;
+	unsigned int i, k, block_id, max_eppi, icfgr_n;
 	const interrupt_prop_t *current_prop;
+	gicv3_intr_block_t blk;
+	uintptr_t reg_base;
 	unsigned int ctlr_enable = 0U;
 
 	/* Make sure there's a valid property array */
@@ -484,39 +672,51 @@ unsigned int gicv3_secure_ppi_sgi_config_props(uintptr_t gicr_base,
 	for (i = 0U; i < interrupt_props_num; i++) {
 		current_prop = &interrupt_props[i];
 
-		if (current_prop->intr_num >= MIN_SPI_ID)
+		if (!IS_RDIST_INTR(current_prop->intr_num))
 			continue;
 
-		/* Configure this interrupt as a secure interrupt */
-		gicr_clr_igroupr0(gicr_base, current_prop->intr_num);
-
-		/* Configure this interrupt as G0 or a G1S interrupt */
-		assert((current_prop->intr_grp == INTR_GROUP0) ||
-				(current_prop->intr_grp == INTR_GROUP1S));
-		if (current_prop->intr_grp == INTR_GROUP1S) {
-			gicr_set_igrpmodr0(gicr_base, current_prop->intr_num);
-			ctlr_enable |= CTLR_ENABLE_G1S_BIT;
-		} else {
-			gicr_clr_igrpmodr0(gicr_base, current_prop->intr_num);
-			ctlr_enable |= CTLR_ENABLE_G0_BIT;
-		}
-
 		/* Set the priority of this interrupt */
-		gicr_set_ipriorityr(gicr_base, current_prop->intr_num,
+		gicr_set_ipriorityr(gicr_base,
+				gicr_intr_pos(current_prop->intr_num),
 				current_prop->intr_pri);
+	}
+
+	max_eppi = MIN_EPPI_ID + gicr_get_num_eppis(gicr_base);
+
+	/* The SGIs and PPIs are followed by the blocks of EPPIs */
+	for (block_id = MIN_SGI_ID; block_id < max_eppi;
+			block_id = (block_id == MIN_SGI_ID) ?
+				   MIN_EPPI_ID : (block_id + 32U)) {
+		ctlr_enable |= gicv3_intr_block_props(block_id,
+				interrupt_props, interrupt_props_num, &blk);
+		if (blk.secure == 0U)
+			continue;
+
+		reg_base = GICR_BIT_REG_BASE(gicr_base, block_id);
+
+		/* Configure the interrupts as secure, G0 or G1S */
+		gicr_write_igroupr0(reg_base, gicr_read_igroupr0(reg_base) &
+				~blk.secure);
+		gicr_write_igrpmodr0(reg_base, (gicr_read_igrpmodr0(reg_base) &
+				~blk.secure) | blk.g1s);
 
 		/*
-		 * Set interrupt configuration for PPIs. Configuration for SGIs
-		 * are ignored.
+		 * Set interrupt configuration for PPIs and EPPIs. The
+		 * configuration of SGIs, in ICFGR0, is ignored.
 		 */
-		if ((current_prop->intr_num >= MIN_PPI_ID) &&
-				(current_prop->intr_num < MIN_SPI_ID)) {
-			gicr_set_icfgr1(gicr_base, current_prop->intr_num,
-					current_prop->intr_cfg);
+		for (k = 0U; k < 2U; k++) {
+			icfgr_n = (gicr_intr_pos(block_id) >> ICFGR_SHIFT) + k;
+			if ((blk.cfg_mask[k] == 0U) || (icfgr_n == 0U))
+				continue;
+
+			reg_base = gicr_base + (icfgr_n << 2);
+			gicr_write_icfgr0(reg_base, (gicr_read_icfgr0(reg_base) &
+					~blk.cfg_mask[k]) | blk.cfg[k]);
 		}
 
-		/* Enable this interrupt */
-		gicr_set_isenabler0(gicr_base, current_prop->intr_num);
+		/* Enable these interrupts */
+		gicr_write_isenabler0(GICR_BIT_REG_BASE(gicr_base, block_id),
+				      blk.secure);
 	}
 
 	return ctlr_enable;
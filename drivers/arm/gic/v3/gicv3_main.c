@@ -31,12 +31,25 @@ static spinlock_t gic_lock;
 #pragma weak gicv3_rdistif_off
 #pragma weak gicv3_rdistif_on
 
+/*
+ * Whether the GICD registers saved and restored across system suspend are reset
+ * to 0 by the GIC implementation. This is weakly bound so that implementation
+ * specific drivers can override it.
+ */
+#pragma weak gicv3_distif_resets_to_zero
 
-/* Helper macros to save and restore GICD registers to and from the context */
-#define RESTORE_GICD_REGS(base, ctx, intr_num, reg, REG)		\
+
+/*
+ * Helper macros to save and restore GICD registers to and from the context.
+ * When 'skip_zero' is true, registers whose saved value is 0 are not written.
+ */
+#define RESTORE_GICD_REGS(base, ctx, intr_num, reg, REG, skip_zero)	\
 	do {								\
 		for (unsigned int int_id = MIN_SPI_ID; int_id < (intr_num); \
 				int_id += (1U << REG##_SHIFT)) {	\
+			if ((skip_zero) && (ctx->gicd_##reg[(int_id -	\
+				MIN_SPI_ID) >> REG##_SHIFT] == 0U))	\
+				continue;				\
 			gicd_write_##reg(base, int_id,			\
 				ctx->gicd_##reg[(int_id - MIN_SPI_ID) >> REG##_SHIFT]); \
 		}							\
@@ -51,6 +64,31 @@ static spinlock_t gic_lock;
 		}							\
 	} while (false)
 
+#if GIC_EXT_INTID
+/* Same as above for the registers of the first 'espi_num' ESPIs */
+#define RESTORE_GICD_EREGS(base, ctx, espi_num, reg, REG, skip_zero)	\
+	do {								\
+		for (unsigned int espi = 0U; espi < (espi_num);		\
+				espi += (1U << REG##_SHIFT)) {		\
+			if ((skip_zero) && (ctx->gicd_##reg##_e[espi >>	\
+				REG##_SHIFT] == 0U))			\
+				continue;				\
+			gicd_write_##reg((base) + (GICD_##REG##E - GICD_##REG),\
+				espi, ctx->gicd_##reg##_e[espi >> REG##_SHIFT]); \
+		}							\
+	} while (false)
+
+#define SAVE_GICD_EREGS(base, ctx, espi_num, reg, REG)			\
+	do {								\
+		for (unsigned int espi = 0U; espi < (espi_num);		\
+				espi += (1U << REG##_SHIFT)) {		\
+			ctx->gicd_##reg##_e[espi >> REG##_SHIFT] =	\
+				gicd_read_##reg((base) +		\
+					(GICD_##REG##E - GICD_##REG), espi); \
+		}							\
+	} while (false)
+#endif
+
 
 /*******************************************************************************
  * This function initialises the ARM GICv3 driver in EL3 with provided platform
@@ -136,6 +174,37 @@ void __init gicv3_driver_init(const gicv3_driver_data_t *plat_driver_data)
 
 }
 
+#if GICV3_PARALLEL_RDIST_WAKE
+/*******************************************************************************
+ * This function powers on and marks as awake the Redistributors of all the
+ * CPUs, and only then waits for them to become active. The wake-up latencies
+ * of the Redistributors then overlap, and each CPU finds its Redistributor
+ * ready when it initialises its GIC interfaces.
+ ******************************************************************************/
+static void __init gicv3_rdistif_wake_all(void)
+{
+	const uintptr_t *rdistif_base_addrs;
+	unsigned int proc_num;
+
+	if (gicv3_driver_data->rdistif_base_addrs == NULL)
+		return;
+
+	rdistif_base_addrs = gicv3_driver_data->rdistif_base_addrs;
+
+	for (proc_num = 0U; proc_num < gicv3_driver_data->rdistif_num;
+			proc_num++) {
+		if (rdistif_base_addrs[proc_num] == 0U)
+			continue;
+
+		gicv3_rdistif_on(proc_num);
+		gicv3_rdistif_kick_awake(rdistif_base_addrs[proc_num]);
+	}
+
+	gicv3_rdistif_wait_all_awake(rdistif_base_addrs,
+				     gicv3_driver_data->rdistif_num);
+}
+#endif
+
 /*******************************************************************************
  * This function initialises the GIC distributor interface based upon the data
  * provided by the platform while initialising the driver.
@@ -174,6 +243,10 @@ void __init gicv3_distif_init(void)
 
 	/* Enable the secure SPIs now that they have been configured */
 	gicd_set_ctlr(gicv3_driver_data->gicd_base, bitmap, RWP_TRUE);
+
+#if GICV3_PARALLEL_RDIST_WAKE
+	gicv3_rdistif_wake_all();
+#endif
 }
 
 /*******************************************************************************
@@ -383,22 +456,24 @@ unsigned int gicv3_get_interrupt_type(unsigned int id,
 	assert(gicv3_driver_data != NULL);
 
 	/* Ensure the parameters are valid */
-	assert((id < PENDING_G1S_INTID) || (id >= MIN_LPI_ID));
+	assert(IS_VALID_INTR(id) || (id >= MIN_LPI_ID));
 	assert(proc_num < gicv3_driver_data->rdistif_num);
 
 	/* All LPI interrupts are Group 1 non secure */
 	if (id >= MIN_LPI_ID)
 		return INTR_GROUP1NS;
 
-	if (id < MIN_SPI_ID) {
+	if (IS_RDIST_INTR(id)) {
 		assert(gicv3_driver_data->rdistif_base_addrs != NULL);
 		gicr_base = gicv3_driver_data->rdistif_base_addrs[proc_num];
-		igroup = gicr_get_igroupr0(gicr_base, id);
-		grpmodr = gicr_get_igrpmodr0(gicr_base, id);
+		igroup = GICR_CALL(gicr_get_igroupr0, gicr_base, id);
+		grpmodr = GICR_CALL(gicr_get_igrpmodr0, gicr_base, id);
 	} else {
 		assert(gicv3_driver_data->gicd_base != 0U);
-		igroup = gicd_get_igroupr(gicv3_driver_data->gicd_base, id);
-		grpmodr = gicd_get_igrpmodr(gicv3_driver_data->gicd_base, id);
+		igroup = GICD_CALL(gicd_get_igroupr, IGROUPR,
+				   gicv3_driver_data->gicd_base, id);
+		grpmodr = GICD_CALL(gicd_get_igrpmodr, IGRPMODR,
+				    gicv3_driver_data->gicd_base, id);
 	}
 
 	/*
@@ -484,6 +559,107 @@ void gicv3_its_restore(uintptr_t gits_base, const gicv3_its_ctx_t * const its_ct
 			(~GITS_CTLR_ENABLED_BIT));
 }
 
+#if GIC_EXT_INTID
+/*****************************************************************************
+ * Helpers to save and restore the registers of the EPPIs implemented by a
+ * Redistributor. Their registers follow those of the SGIs and PPIs, so the
+ * accessors of the latter are used with an offset base address.
+ *****************************************************************************/
+static void gicv3_rdistif_save_eppis(uintptr_t gicr_base,
+				     gicv3_redist_ctx_t * const rdist_ctx)
+{
+	unsigned int i, num_eppis = gicr_get_num_eppis(gicr_base);
+	uintptr_t base;
+
+	assert(num_eppis <= TOTAL_EPPI_INTR_NUM);
+
+	for (i = 0U; i < num_eppis; i += (1U << IGROUPR_SHIFT)) {
+		base = GICR_BIT_REG_BASE(gicr_base, MIN_EPPI_ID + i);
+
+		rdist_ctx->gicr_igroupr_e[i >> IGROUPR_SHIFT] =
+				gicr_read_igroupr0(base);
+		rdist_ctx->gicr_isenabler_e[i >> ISENABLER_SHIFT] =
+				gicr_read_isenabler0(base);
+		rdist_ctx->gicr_ispendr_e[i >> ISPENDR_SHIFT] =
+				gicr_read_ispendr0(base);
+		rdist_ctx->gicr_isactiver_e[i >> ISACTIVER_SHIFT] =
+				gicr_read_isactiver0(base);
+		rdist_ctx->gicr_igrpmodr_e[i >> IGRPMODR_SHIFT] =
+				gicr_read_igrpmodr0(base);
+	}
+
+	for (i = 0U; i < num_eppis; i += (1U << ICFGR_SHIFT)) {
+		rdist_ctx->gicr_icfgr_e[i >> ICFGR_SHIFT] = gicr_read_icfgr0(
+				gicr_base + (((i >> ICFGR_SHIFT) + 2U) << 2));
+	}
+
+	for (i = 0U; i < num_eppis; i += (1U << IPRIORITYR_SHIFT)) {
+		rdist_ctx->gicr_ipriorityr_e[i >> IPRIORITYR_SHIFT] =
+				gicr_read_ipriorityr(gicr_base, MIN_SPI_ID + i);
+	}
+}
+
+/* Disable the EPPIs, and restore their configuration but not their state */
+static void gicv3_rdistif_restore_eppis_config(uintptr_t gicr_base,
+		const gicv3_redist_ctx_t * const rdist_ctx)
+{
+	unsigned int i, num_eppis = gicr_get_num_eppis(gicr_base);
+	uintptr_t base;
+
+	assert(num_eppis <= TOTAL_EPPI_INTR_NUM);
+
+	for (i = 0U; i < num_eppis; i += (1U << ICENABLER_SHIFT)) {
+		base = GICR_BIT_REG_BASE(gicr_base, MIN_EPPI_ID + i);
+		gicr_write_icenabler0(base, ~0U);
+	}
+	gicr_wait_for_pending_write(gicr_base);
+
+	for (i = 0U; i < num_eppis; i += (1U << IGROUPR_SHIFT)) {
+		base = GICR_BIT_REG_BASE(gicr_base, MIN_EPPI_ID + i);
+
+		gicr_write_igroupr0(base,
+				rdist_ctx->gicr_igroupr_e[i >> IGROUPR_SHIFT]);
+		gicr_write_igrpmodr0(base,
+				rdist_ctx->gicr_igrpmodr_e[i >> IGRPMODR_SHIFT]);
+	}
+
+	for (i = 0U; i < num_eppis; i += (1U << IPRIORITYR_SHIFT)) {
+		gicr_write_ipriorityr(gicr_base, MIN_SPI_ID + i,
+			rdist_ctx->gicr_ipriorityr_e[i >> IPRIORITYR_SHIFT]);
+	}
+
+	for (i = 0U; i < num_eppis; i += (1U << ICFGR_SHIFT)) {
+		gicr_write_icfgr0(gicr_base + (((i >> ICFGR_SHIFT) + 2U) << 2),
+				rdist_ctx->gicr_icfgr_e[i >> ICFGR_SHIFT]);
+	}
+}
+
+/* Restore the pending and active state of the EPPIs, then enable them */
+static void gicv3_rdistif_restore_eppis_state(uintptr_t gicr_base,
+		const gicv3_redist_ctx_t * const rdist_ctx)
+{
+	unsigned int i, num_eppis = gicr_get_num_eppis(gicr_base);
+	uintptr_t base;
+
+	for (i = 0U; i < num_eppis; i += (1U << ISPENDR_SHIFT)) {
+		base = GICR_BIT_REG_BASE(gicr_base, MIN_EPPI_ID + i);
+
+		gicr_write_ispendr0(base,
+				rdist_ctx->gicr_ispendr_e[i >> ISPENDR_SHIFT]);
+		gicr_write_isactiver0(base,
+			rdist_ctx->gicr_isactiver_e[i >> ISACTIVER_SHIFT]);
+	}
+
+	gicr_wait_for_upstream_pending_write(gicr_base);
+
+	for (i = 0U; i < num_eppis; i += (1U << ISENABLER_SHIFT)) {
+		base = GICR_BIT_REG_BASE(gicr_base, MIN_EPPI_ID + i);
+		gicr_write_isenabler0(base,
+			rdist_ctx->gicr_isenabler_e[i >> ISENABLER_SHIFT]);
+	}
+}
+#endif /* GIC_EXT_INTID */
+
 /*****************************************************************************
  * Function to save the GIC Redistributor register context. This function
  * must be invoked after CPU interface disable and prior to Distributor save.
@@ -526,6 +702,9 @@ void gicv3_rdistif_save(unsigned int proc_num, gicv3_redist_ctx_t * const rdist_
 				gicr_read_ipriorityr(gicr_base, int_id);
 	}
 
+#if GIC_EXT_INTID
+	gicv3_rdistif_save_eppis(gicr_base, rdist_ctx);
+#endif
 
 	/*
 	 * Call the pre-save hook that implements the IMP DEF sequence that may
@@ -600,6 +779,10 @@ void gicv3_rdistif_init_restore(unsigned int proc_num,
 	gicr_write_igrpmodr0(gicr_base, rdist_ctx->gicr_igrpmodr0);
 	gicr_write_nsacr(gicr_base, rdist_ctx->gicr_nsacr);
 
+#if GIC_EXT_INTID
+	gicv3_rdistif_restore_eppis_config(gicr_base, rdist_ctx);
+#endif
+
 	/* Restore after group and priorities are set */
 	gicr_write_ispendr0(gicr_base, rdist_ctx->gicr_ispendr0);
 	gicr_write_isactiver0(gicr_base, rdist_ctx->gicr_isactiver0);
@@ -611,6 +794,10 @@ void gicv3_rdistif_init_restore(unsigned int proc_num,
 	gicr_wait_for_upstream_pending_write(gicr_base);
 	gicr_write_isenabler0(gicr_base, rdist_ctx->gicr_isenabler0);
 
+#if GIC_EXT_INTID
+	gicv3_rdistif_restore_eppis_state(gicr_base, rdist_ctx);
+#endif
+
 	/*
 	 * Restore GICR_CTLR.Enable_LPIs bit and wait for pending writes in case
 	 * the first write to GICR_CTLR was still in flight (this write only
@@ -621,6 +808,11 @@ void gicv3_rdistif_init_restore(unsigned int proc_num,
 	gicr_wait_for_pending_write(gicr_base);
 }
 
+bool gicv3_distif_resets_to_zero(void)
+{
+	return false;
+}
+
 /*****************************************************************************
  * Function to save the GIC Distributor register context. This function
  * must be invoked after CPU interface disable and Redistributor save.
@@ -628,6 +820,9 @@ void gicv3_rdistif_init_restore(unsigned int proc_num,
 void gicv3_distif_save(gicv3_dist_ctx_t * const dist_ctx)
 {
 	unsigned int num_ints;
+#if GIC_EXT_INTID
+	unsigned int num_espis;
+#endif
 
 	assert(gicv3_driver_data != NULL);
 	assert(gicv3_driver_data->gicd_base != 0U);
@@ -677,6 +872,28 @@ void gicv3_distif_save(gicv3_dist_ctx_t * const dist_ctx)
 	/* Save GICD_IROUTER for INTIDs 32 - 1019 */
 	SAVE_GICD_REGS(gicd_base, dist_ctx, num_ints, irouter, IROUTER);
 
+#if GIC_EXT_INTID
+	/* Save the registers of the implemented ESPIs */
+	num_espis = gicd_get_num_espis(gicd_base);
+	assert(num_espis <= TOTAL_ESPI_INTR_NUM);
+	if (num_espis > TOTAL_ESPI_INTR_NUM)
+		num_espis = TOTAL_ESPI_INTR_NUM;
+
+	SAVE_GICD_EREGS(gicd_base, dist_ctx, num_espis, igroupr, IGROUPR);
+	SAVE_GICD_EREGS(gicd_base, dist_ctx, num_espis, isenabler, ISENABLER);
+	SAVE_GICD_EREGS(gicd_base, dist_ctx, num_espis, ispendr, ISPENDR);
+	SAVE_GICD_EREGS(gicd_base, dist_ctx, num_espis, isactiver, ISACTIVER);
+	SAVE_GICD_EREGS(gicd_base, dist_ctx, num_espis, ipriorityr, IPRIORITYR);
+	SAVE_GICD_EREGS(gicd_base, dist_ctx, num_espis, icfgr, ICFGR);
+	SAVE_GICD_EREGS(gicd_base, dist_ctx, num_espis, igrpmodr, IGRPMODR);
+	SAVE_GICD_EREGS(gicd_base, dist_ctx, num_espis, nsacr, NSACR);
+
+	for (unsigned int i = 0U; i < num_espis; i++) {
+		dist_ctx->gicd_irouter_e[i] =
+			gicd_read_irouter(gicd_base, MIN_ESPI_ID + i);
+	}
+#endif
+
 	/*
 	 * GICD_ITARGETSR<n> and GICD_SPENDSGIR<n> are RAZ/WI when
 	 * GICD_CTLR.ARE_(S|NS) bits are set which is the case for our GICv3
@@ -694,6 +911,10 @@ void gicv3_distif_save(gicv3_dist_ctx_t * const dist_ctx)
 void gicv3_distif_init_restore(const gicv3_dist_ctx_t * const dist_ctx)
 {
 	unsigned int num_ints = 0U;
+#if GIC_EXT_INTID
+	unsigned int num_espis;
+#endif
+	bool skip_reset_vals;
 
 	assert(gicv3_driver_data != NULL);
 	assert(gicv3_driver_data->gicd_base != 0U);
@@ -702,6 +923,15 @@ void gicv3_distif_init_restore(const gicv3_dist_ctx_t * const dist_ctx)
 
 	uintptr_t gicd_base = gicv3_driver_data->gicd_base;
 
+	/*
+	 * The driver always sets ARE_S, so finding it clear means that the
+	 * Distributor has been reset since its context was saved. Registers
+	 * whose saved value is their reset value then needn't be written,
+	 * which avoids most of the writes for the SPIs that aren't in use.
+	 */
+	skip_reset_vals = gicv3_distif_resets_to_zero() &&
+		((gicd_read_ctlr(gicd_base) & CTLR_ARE_S_BIT) == 0U);
+
 	/*
 	 * Clear the "enable" bits for G0/G1S/G1NS interrupts before configuring
 	 * the ARE_S bit. The Distributor might generate a system error
@@ -725,36 +955,81 @@ void gicv3_distif_init_restore(const gicv3_dist_ctx_t * const dist_ctx)
 		num_ints = MAX_SPI_ID + 1U;
 
 	/* Restore GICD_IGROUPR for INTIDs 32 - 1019 */
-	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, igroupr, IGROUPR);
+	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, igroupr, IGROUPR,
+			  skip_reset_vals);
 
 	/* Restore GICD_IPRIORITYR for INTIDs 32 - 1019 */
-	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, ipriorityr, IPRIORITYR);
+	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, ipriorityr, IPRIORITYR,
+			  skip_reset_vals);
 
 	/* Restore GICD_ICFGR for INTIDs 32 - 1019 */
-	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, icfgr, ICFGR);
+	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, icfgr, ICFGR,
+			  skip_reset_vals);
 
 	/* Restore GICD_IGRPMODR for INTIDs 32 - 1019 */
-	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, igrpmodr, IGRPMODR);
+	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, igrpmodr, IGRPMODR,
+			  skip_reset_vals);
 
 	/* Restore GICD_NSACR for INTIDs 32 - 1019 */
-	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, nsacr, NSACR);
+	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, nsacr, NSACR,
+			  skip_reset_vals);
 
 	/* Restore GICD_IROUTER for INTIDs 32 - 1019 */
-	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, irouter, IROUTER);
+	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, irouter, IROUTER,
+			  skip_reset_vals);
+
+#if GIC_EXT_INTID
+	/* Restore the configuration of the implemented ESPIs */
+	num_espis = gicd_get_num_espis(gicd_base);
+	assert(num_espis <= TOTAL_ESPI_INTR_NUM);
+	if (num_espis > TOTAL_ESPI_INTR_NUM)
+		num_espis = TOTAL_ESPI_INTR_NUM;
+
+	RESTORE_GICD_EREGS(gicd_base, dist_ctx, num_espis, igroupr, IGROUPR,
+			   skip_reset_vals);
+	RESTORE_GICD_EREGS(gicd_base, dist_ctx, num_espis, ipriorityr,
+			   IPRIORITYR, skip_reset_vals);
+	RESTORE_GICD_EREGS(gicd_base, dist_ctx, num_espis, icfgr, ICFGR,
+			   skip_reset_vals);
+	RESTORE_GICD_EREGS(gicd_base, dist_ctx, num_espis, igrpmodr, IGRPMODR,
+			   skip_reset_vals);
+	RESTORE_GICD_EREGS(gicd_base, dist_ctx, num_espis, nsacr, NSACR,
+			   skip_reset_vals);
+
+	for (unsigned int i = 0U; i < num_espis; i++) {
+		if (skip_reset_vals && (dist_ctx->gicd_irouter_e[i] == 0U))
+			continue;
+		gicd_write_irouter(gicd_base, MIN_ESPI_ID + i,
+				   dist_ctx->gicd_irouter_e[i]);
+	}
+#endif
 
 	/*
 	 * Restore ISENABLER, ISPENDR and ISACTIVER after the interrupts are
-	 * configured.
+	 * configured. Writing 0 to these registers has no effect, so it is
+	 * always skipped.
 	 */
 
 	/* Restore GICD_ISENABLER for INT_IDs 32 - 1019 */
-	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, isenabler, ISENABLER);
+	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, isenabler, ISENABLER,
+			  true);
 
 	/* Restore GICD_ISPENDR for INTIDs 32 - 1019 */
-	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, ispendr, ISPENDR);
+	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, ispendr, ISPENDR,
+			  true);
 
 	/* Restore GICD_ISACTIVER for INTIDs 32 - 1019 */
-	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, isactiver, ISACTIVER);
+	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, isactiver, ISACTIVER,
+			  true);
+
+#if GIC_EXT_INTID
+	RESTORE_GICD_EREGS(gicd_base, dist_ctx, num_espis, isenabler,
+			   ISENABLER, true);
+	RESTORE_GICD_EREGS(gicd_base, dist_ctx, num_espis, ispendr, ISPENDR,
+			   true);
+	RESTORE_GICD_EREGS(gicd_base, dist_ctx, num_espis, isactiver,
+			   ISACTIVER, true);
+#endif
 
 	/* Restore the GICD_CTLR */
 	gicd_write_ctlr(gicd_base, dist_ctx->gicd_ctlr);
@@ -785,14 +1060,15 @@ unsigned int gicv3_get_interrupt_active(unsigned int id, unsigned int proc_num)
 	assert(gicv3_driver_data->gicd_base != 0U);
 	assert(proc_num < gicv3_driver_data->rdistif_num);
 	assert(gicv3_driver_data->rdistif_base_addrs != NULL);
-	assert(id <= MAX_SPI_ID);
+	assert(IS_VALID_INTR(id));
 
-	if (id < MIN_SPI_ID) {
-		/* For SGIs and PPIs */
-		value = gicr_get_isactiver0(
+	if (IS_RDIST_INTR(id)) {
+		/* For SGIs, PPIs and EPPIs */
+		value = GICR_CALL(gicr_get_isactiver0,
 				gicv3_driver_data->rdistif_base_addrs[proc_num], id);
 	} else {
-		value = gicd_get_isactiver(gicv3_driver_data->gicd_base, id);
+		value = GICD_CALL(gicd_get_isactiver, ISACTIVER,
+				  gicv3_driver_data->gicd_base, id);
 	}
 
 	return value;
@@ -809,20 +1085,21 @@ void gicv3_enable_interrupt(unsigned int id, unsigned int proc_num)
 	assert(gicv3_driver_data->gicd_base != 0U);
 	assert(proc_num < gicv3_driver_data->rdistif_num);
 	assert(gicv3_driver_data->rdistif_base_addrs != NULL);
-	assert(id <= MAX_SPI_ID);
+	assert(IS_VALID_INTR(id));
 
 	/*
 	 * Ensure that any shared variable updates depending on out of band
 	 * interrupt trigger are observed before enabling interrupt.
 	 */
 	dsbishst();
-	if (id < MIN_SPI_ID) {
-		/* For SGIs and PPIs */
-		gicr_set_isenabler0(
+	if (IS_RDIST_INTR(id)) {
+		/* For SGIs, PPIs and EPPIs */
+		GICR_CALL(gicr_set_isenabler0,
 				gicv3_driver_data->rdistif_base_addrs[proc_num],
 				id);
 	} else {
-		gicd_set_isenabler(gicv3_driver_data->gicd_base, id);
+		GICD_CALL(gicd_set_isenabler, ISENABLER,
+			  gicv3_driver_data->gicd_base, id);
 	}
 }
 
@@ -837,15 +1114,15 @@ void gicv3_disable_interrupt(unsigned int id, unsigned int proc_num)
 	assert(gicv3_driver_data->gicd_base != 0U);
 	assert(proc_num < gicv3_driver_data->rdistif_num);
 	assert(gicv3_driver_data->rdistif_base_addrs != NULL);
-	assert(id <= MAX_SPI_ID);
+	assert(IS_VALID_INTR(id));
 
 	/*
 	 * Disable interrupt, and ensure that any shared variable updates
 	 * depending on out of band interrupt trigger are observed afterwards.
 	 */
-	if (id < MIN_SPI_ID) {
-		/* For SGIs and PPIs */
-		gicr_set_icenabler0(
+	if (IS_RDIST_INTR(id)) {
+		/* For SGIs, PPIs and EPPIs */
+		GICR_CALL(gicr_set_icenabler0,
 				gicv3_driver_data->rdistif_base_addrs[proc_num],
 				id);
 
@@ -853,7 +1130,8 @@ void gicv3_disable_interrupt(unsigned int id, unsigned int proc_num)
 		gicr_wait_for_pending_write(
 				gicv3_driver_data->rdistif_base_addrs[proc_num]);
 	} else {
-		gicd_set_icenabler(gicv3_driver_data->gicd_base, id);
+		GICD_CALL(gicd_set_icenabler, ICENABLER,
+			  gicv3_driver_data->gicd_base, id);
 
 		/* Write to clear enable requires waiting for pending writes */
 		gicd_wait_for_pending_write(gicv3_driver_data->gicd_base);
@@ -862,6 +1140,85 @@ void gicv3_disable_interrupt(unsigned int id, unsigned int proc_num)
 	dsbishst();
 }
 
+/*
+ * Write a mask of the SPIs or ESPIs in the range to the registers holding one
+ * bit per interrupt, one block of 32 interrupts at a time. 'espi_offset' is
+ * the offset of the ESPI registers from the SPI ones.
+ */
+static void gicv3_write_spi_range(unsigned int id, unsigned int num,
+		void (*write_fn)(uintptr_t base, unsigned int id,
+				 unsigned int val),
+		uintptr_t espi_offset)
+{
+	uintptr_t gicd_base = gicv3_driver_data->gicd_base;
+	unsigned int bit, cnt, end;
+	uint32_t mask;
+
+	if (IS_ESPI(id)) {
+		gicd_base += espi_offset;
+		id -= MIN_ESPI_ID;
+	}
+
+	end = id + num;
+	while (id < end) {
+		bit = id & ((1U << ISENABLER_SHIFT) - 1U);
+		cnt = MIN((1U << ISENABLER_SHIFT) - bit, end - id);
+		mask = (cnt == 32U) ? ~0U : ((BIT_32(cnt) - 1U) << bit);
+
+		write_fn(gicd_base, id, mask);
+		id += cnt;
+	}
+}
+
+/* Whether a range of interrupts is within the SPIs or within the ESPIs */
+static inline bool is_spi_range(unsigned int id, unsigned int num)
+{
+	return ((id >= MIN_SPI_ID) && ((id + num - 1U) <= MAX_SPI_ID)) ||
+		(IS_ESPI(id) && IS_ESPI(id + num - 1U));
+}
+
+/*******************************************************************************
+ * This function enables the 'num' SPIs or ESPIs starting with the one
+ * identified by id. The GICD_ISENABLER registers are written once for each
+ * block of 32 interrupts, rather than once per interrupt.
+ ******************************************************************************/
+void gicv3_enable_spi_range(unsigned int id, unsigned int num)
+{
+	assert(gicv3_driver_data != NULL);
+	assert(gicv3_driver_data->gicd_base != 0U);
+	assert(num > 0U);
+	assert(is_spi_range(id, num));
+
+	/*
+	 * Ensure that any shared variable updates depending on out of band
+	 * interrupt trigger are observed before enabling interrupts.
+	 */
+	dsbishst();
+	gicv3_write_spi_range(id, num, gicd_write_isenabler,
+			      GICD_ISENABLERE - GICD_ISENABLER);
+}
+
+/*******************************************************************************
+ * This function disables the 'num' SPIs or ESPIs starting with the one
+ * identified by id, writing the GICD_ICENABLER registers once for each block
+ * of 32 interrupts.
+ ******************************************************************************/
+void gicv3_disable_spi_range(unsigned int id, unsigned int num)
+{
+	assert(gicv3_driver_data != NULL);
+	assert(gicv3_driver_data->gicd_base != 0U);
+	assert(num > 0U);
+	assert(is_spi_range(id, num));
+
+	gicv3_write_spi_range(id, num, gicd_write_icenabler,
+			      GICD_ICENABLERE - GICD_ICENABLER);
+
+	/* Write to clear enable requires waiting for pending writes */
+	gicd_wait_for_pending_write(gicv3_driver_data->gicd_base);
+
+	dsbishst();
+}
+
 /*******************************************************************************
  * This function sets the interrupt priority as supplied for the given interrupt
  * id.
@@ -875,13 +1232,14 @@ void gicv3_set_interrupt_priority(unsigned int id, unsigned int proc_num,
 	assert(gicv3_driver_data->gicd_base != 0U);
 	assert(proc_num < gicv3_driver_data->rdistif_num);
 	assert(gicv3_driver_data->rdistif_base_addrs != NULL);
-	assert(id <= MAX_SPI_ID);
+	assert(IS_VALID_INTR(id));
 
-	if (id < MIN_SPI_ID) {
+	if (IS_RDIST_INTR(id)) {
 		gicr_base = gicv3_driver_data->rdistif_base_addrs[proc_num];
-		gicr_set_ipriorityr(gicr_base, id, priority);
+		gicr_set_ipriorityr(gicr_base, gicr_intr_pos(id), priority);
 	} else {
-		gicd_set_ipriorityr(gicv3_driver_data->gicd_base, id, priority);
+		GICD_CALL(gicd_set_ipriorityr, IPRIORITYR,
+			  gicv3_driver_data->gicd_base, id, priority);
 	}
 }
 
@@ -894,7 +1252,7 @@ void gicv3_set_interrupt_type(unsigned int id, unsigned int proc_num,
 		unsigned int type)
 {
 	bool igroup = false, grpmod = false;
-	uintptr_t gicr_base;
+	uintptr_t gicr_base, gicd_base;
 
 	assert(gicv3_driver_data != NULL);
 	assert(gicv3_driver_data->gicd_base != 0U);
@@ -919,29 +1277,31 @@ void gicv3_set_interrupt_type(unsigned int id, unsigned int proc_num,
 		break;
 	}
 
-	if (id < MIN_SPI_ID) {
+	if (IS_RDIST_INTR(id)) {
 		gicr_base = gicv3_driver_data->rdistif_base_addrs[proc_num];
 		if (igroup)
-			gicr_set_igroupr0(gicr_base, id);
+			GICR_CALL(gicr_set_igroupr0, gicr_base, id);
 		else
-			gicr_clr_igroupr0(gicr_base, id);
+			GICR_CALL(gicr_clr_igroupr0, gicr_base, id);
 
 		if (grpmod)
-			gicr_set_igrpmodr0(gicr_base, id);
+			GICR_CALL(gicr_set_igrpmodr0, gicr_base, id);
 		else
-			gicr_clr_igrpmodr0(gicr_base, id);
+			GICR_CALL(gicr_clr_igrpmodr0, gicr_base, id);
 	} else {
+		gicd_base = gicv3_driver_data->gicd_base;
+
 		/* Serialize read-modify-write to Distributor registers */
 		spin_lock(&gic_lock);
 		if (igroup)
-			gicd_set_igroupr(gicv3_driver_data->gicd_base, id);
+			GICD_CALL(gicd_set_igroupr, IGROUPR, gicd_base, id);
 		else
-			gicd_clr_igroupr(gicv3_driver_data->gicd_base, id);
+			GICD_CALL(gicd_clr_igroupr, IGROUPR, gicd_base, id);
 
 		if (grpmod)
-			gicd_set_igrpmodr(gicv3_driver_data->gicd_base, id);
+			GICD_CALL(gicd_set_igrpmodr, IGRPMODR, gicd_base, id);
 		else
-			gicd_clr_igrpmodr(gicv3_driver_data->gicd_base, id);
+			GICD_CALL(gicd_clr_igrpmodr, IGRPMODR, gicd_base, id);
 		spin_unlock(&gic_lock);
 	}
 }
@@ -1005,7 +1365,7 @@ void gicv3_set_spi_routing(unsigned int id, unsigned int irm, u_register_t mpidr
 	assert(gicv3_driver_data->gicd_base != 0U);
 
 	assert((irm == GICV3_IRM_ANY) || (irm == GICV3_IRM_PE));
-	assert((id >= MIN_SPI_ID) && (id <= MAX_SPI_ID));
+	assert(!IS_RDIST_INTR(id) && IS_VALID_INTR(id));
 
 	aff = gicd_irouter_val_from_mpidr(mpidr, irm);
 	gicd_write_irouter(gicv3_driver_data->gicd_base, id, aff);
@@ -1039,12 +1399,13 @@ void gicv3_clear_interrupt_pending(unsigned int id, unsigned int proc_num)
 	 * Clear pending interrupt, and ensure that any shared variable updates
 	 * depending on out of band interrupt trigger are observed afterwards.
 	 */
-	if (id < MIN_SPI_ID) {
-		/* For SGIs and PPIs */
-		gicr_set_icpendr0(gicv3_driver_data->rdistif_base_addrs[proc_num],
-				id);
+	if (IS_RDIST_INTR(id)) {
+		/* For SGIs, PPIs and EPPIs */
+		GICR_CALL(gicr_set_icpendr0,
+			  gicv3_driver_data->rdistif_base_addrs[proc_num], id);
 	} else {
-		gicd_set_icpendr(gicv3_driver_data->gicd_base, id);
+		GICD_CALL(gicd_set_icpendr, ICPENDR,
+			  gicv3_driver_data->gicd_base, id);
 	}
 	dsbishst();
 }
@@ -1066,12 +1427,13 @@ void gicv3_set_interrupt_pending(unsigned int id, unsigned int proc_num)
 	 * interrupt trigger are observed before setting interrupt pending.
 	 */
 	dsbishst();
-	if (id < MIN_SPI_ID) {
-		/* For SGIs and PPIs */
-		gicr_set_ispendr0(gicv3_driver_data->rdistif_base_addrs[proc_num],
-				id);
+	if (IS_RDIST_INTR(id)) {
+		/* For SGIs, PPIs and EPPIs */
+		GICR_CALL(gicr_set_ispendr0,
+			  gicv3_driver_data->rdistif_base_addrs[proc_num], id);
 	} else {
-		gicd_set_ispendr(gicv3_driver_data->gicd_base, id);
+		GICD_CALL(gicd_set_ispendr, ISPENDR,
+			  gicv3_driver_data->gicd_base, id);
 	}
 }
 
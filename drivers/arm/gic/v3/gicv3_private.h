@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -8,6 +8,7 @@
 #define GICV3_PRIVATE_H
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <drivers/arm/gic_common.h>
@@ -24,6 +25,55 @@
 #define RWP_TRUE		U(1)
 #define RWP_FALSE		U(0)
 
+/* Macros to categorise the GICv3.1 extended interrupts */
+#if GIC_EXT_INTID
+#define IS_EPPI(id)	(((id) >= MIN_EPPI_ID) && ((id) <= MAX_EPPI_ID))
+#define IS_ESPI(id)	(((id) >= MIN_ESPI_ID) && ((id) <= MAX_ESPI_ID))
+#else
+#define IS_EPPI(id)	false
+#define IS_ESPI(id)	false
+#endif
+
+/* Whether an interrupt is configured in the Redistributor */
+#define IS_RDIST_INTR(id)	(((id) < MIN_SPI_ID) || IS_EPPI(id))
+
+/* Whether an interrupt is an SGI, PPI or SPI, or an EPPI or ESPI if enabled */
+#define IS_VALID_INTR(id)	(((id) <= MAX_SPI_ID) || IS_EPPI(id) || \
+				 IS_ESPI(id))
+
+/*
+ * Call the GICD accessor 'fn' for the register REG of the SPI or ESPI 'id'.
+ * The registers of the ESPIs are laid out like those of interrupts 0 onwards,
+ * from another offset, so the same accessors are used for them by passing the
+ * ESPI number and a Distributor base address moved by the difference.
+ */
+#define GICD_CALL(fn, REG, base, id, ...)				\
+	(IS_ESPI(id) ?							\
+	 fn((base) + (GICD_##REG##E - GICD_##REG), (id) - MIN_ESPI_ID,	\
+	    ##__VA_ARGS__) :						\
+	 fn((base), (id), ##__VA_ARGS__))
+
+/*
+ * Position of an SGI, PPI or EPPI in the Redistributor registers, in which the
+ * EPPIs immediately follow the PPIs.
+ */
+static inline unsigned int gicr_intr_pos(unsigned int id)
+{
+	return IS_EPPI(id) ? (id - MIN_EPPI_ID + MIN_SPI_ID) : id;
+}
+
+/*
+ * Redistributor base address moved so that the accessors of a register 0 with
+ * one bit per interrupt, e.g. GICR_ISENABLER0, access the register of the same
+ * kind that holds the bit of the SGI, PPI or EPPI 'id'.
+ */
+#define GICR_BIT_REG_BASE(base, id)	\
+	((base) + ((gicr_intr_pos(id) >> 5U) << 2U))
+
+/* Call such an accessor 'fn', taking an interrupt ID, for 'id' */
+#define GICR_CALL(fn, base, id, ...)					\
+	fn(GICR_BIT_REG_BASE(base, id), gicr_intr_pos(id), ##__VA_ARGS__)
+
 /*
  * Macro to convert an mpidr to a value suitable for programming into a
  * GICD_IROUTER. Bits[31:24] in the MPIDR are cleared as they are not relevant
@@ -108,6 +158,9 @@ void gicv3_rdistif_base_addrs_probe(uintptr_t *rdistif_base_addrs,
 					uintptr_t gicr_base,
 					mpidr_hash_fn mpidr_to_core_pos);
 void gicv3_rdistif_mark_core_awake(uintptr_t gicr_base);
+void gicv3_rdistif_kick_awake(uintptr_t gicr_base);
+void gicv3_rdistif_wait_all_awake(const uintptr_t *rdistif_base_addrs,
+				  unsigned int rdistif_num);
 void gicv3_rdistif_mark_core_asleep(uintptr_t gicr_base);
 
 /*******************************************************************************
@@ -133,6 +186,10 @@ static inline unsigned int gicd_read_pidr2(uintptr_t base)
 static inline unsigned long long gicd_read_irouter(uintptr_t base, unsigned int id)
 {
 	assert(id >= MIN_SPI_ID);
+	if (IS_ESPI(id))
+		return mmio_read_64(base + GICD_IROUTERE +
+				    ((id - MIN_ESPI_ID) << 3));
+
 	return mmio_read_64(base + GICD_IROUTER + (id << 3));
 }
 
@@ -141,9 +198,31 @@ static inline void gicd_write_irouter(uintptr_t base,
 				      unsigned long long affinity)
 {
 	assert(id >= MIN_SPI_ID);
+	if (IS_ESPI(id)) {
+		mmio_write_64(base + GICD_IROUTERE + ((id - MIN_ESPI_ID) << 3),
+			      affinity);
+		return;
+	}
+
 	mmio_write_64(base + GICD_IROUTER + (id << 3), affinity);
 }
 
+/* Number of ESPIs implemented by the Distributor */
+static inline unsigned int gicd_get_num_espis(uintptr_t base)
+{
+#if GIC_EXT_INTID
+	unsigned int typer = gicd_read_typer(base);
+
+	if ((typer & TYPER_ESPI_BIT) == 0U)
+		return 0U;
+
+	return (((typer >> TYPER_ESPI_RANGE_SHIFT) & TYPER_ESPI_RANGE_MASK) +
+		1U) << 5;
+#else
+	return 0U;
+#endif
+}
+
 static inline void gicd_clr_ctlr(uintptr_t base,
 				 unsigned int bitmap,
 				 unsigned int rwp)
@@ -180,6 +259,19 @@ static inline unsigned long long gicr_read_typer(uintptr_t base)
 	return mmio_read_64(base + GICR_TYPER);
 }
 
+/* Number of EPPIs implemented by a Redistributor */
+static inline unsigned int gicr_get_num_eppis(uintptr_t base)
+{
+#if GIC_EXT_INTID
+	unsigned int ppi_num = (unsigned int)(gicr_read_typer(base) >>
+			TYPER_PPI_NUM_SHIFT) & TYPER_PPI_NUM_MASK;
+
+	return ppi_num << 5;
+#else
+	return 0U;
+#endif
+}
+
 static inline unsigned int gicr_read_waker(uintptr_t base)
 {
 	return mmio_read_32(base + GICR_WAKER);
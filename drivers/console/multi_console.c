@@ -5,12 +5,43 @@
  */
 
 #include <assert.h>
+#include <stdbool.h>
+
+#include <platform_def.h>
 
 #include <drivers/console.h>
+#include <lib/cassert.h>
+#include <lib/spinlock.h>
 
 console_t *console_list;
 uint8_t console_state = CONSOLE_FLAG_BOOT;
 
+#if CONSOLE_BUF_ENABLED
+/*
+ * In the runtime state, console_putc() appends characters to a ring shared by
+ * all CPUs, and only writes as many of them out as the consoles can take
+ * without waiting, so that logging doesn't stall the caller for the time it
+ * takes to transmit the message. The rest is written out by the next calls,
+ * or by console_flush(). The panic and crash reporting paths print what is
+ * left through the crash console without taking the lock, see
+ * asm_print_console_buf. Must be a power of 2.
+ */
+#ifndef PLAT_CONSOLE_BUF_SIZE
+#define PLAT_CONSOLE_BUF_SIZE		U(4096)
+#endif
+
+CASSERT((PLAT_CONSOLE_BUF_SIZE & (PLAT_CONSOLE_BUF_SIZE - 1U)) == 0U,
+	assert_console_buf_size_not_power_of_2);
+
+char console_buf[PLAT_CONSOLE_BUF_SIZE];
+const unsigned int console_buf_mask = PLAT_CONSOLE_BUF_SIZE - 1U;
+/* Free-running indices of the next character to add and to write out */
+unsigned int console_buf_head, console_buf_tail;
+static spinlock_t console_buf_lock;
+
+static void console_buf_drain(bool wait);
+#endif /* CONSOLE_BUF_ENABLED */
+
 IMPORT_SYM(console_t *, __STACKS_START__, stacks_start)
 IMPORT_SYM(console_t *, __STACKS_END__, stacks_end)
 
@@ -60,6 +91,20 @@ int console_is_registered(console_t *to_find)
 
 void console_switch_state(unsigned int new_state)
 {
+#if CONSOLE_BUF_ENABLED
+	/*
+	 * Write the buffered characters out to the consoles of the state they
+	 * were output in. Don't take the lock when crashing, as the crash may
+	 * have happened with it held.
+	 */
+	if (new_state == CONSOLE_FLAG_CRASH) {
+		console_buf_drain(true);
+	} else {
+		spin_lock(&console_buf_lock);
+		console_buf_drain(true);
+		spin_unlock(&console_buf_lock);
+	}
+#endif
 	console_state = new_state;
 }
 
@@ -84,11 +129,78 @@ static int do_putc(int c, console_t *console)
 	return console->putc(c, console);
 }
 
+#if CONSOLE_BUF_ENABLED
+/* Check that all consoles of the current state can take a character */
+static bool console_buf_tx_ready(void)
+{
+	console_t *console;
+
+	for (console = console_list; console != NULL; console = console->next)
+		if ((console->flags & console_state) && console->putc &&
+		    console->tx_ready && (console->tx_ready(console) == 0))
+			return false;
+
+	return true;
+}
+
+/* Write the oldest buffered character out to the consoles of the state */
+static void console_buf_write_one(void)
+{
+	console_t *console;
+	int c;
+
+	c = console_buf[console_buf_tail & (PLAT_CONSOLE_BUF_SIZE - 1U)];
+	for (console = console_list; console != NULL; console = console->next)
+		if ((console->flags & console_state) && console->putc)
+			(void)do_putc(c, console);
+
+	console_buf_tail++;
+}
+
+/*
+ * Write buffered characters out to the consoles of the current state. Unless
+ * 'wait' is set, stop as soon as one of them would have to wait. Must be
+ * called with console_buf_lock held.
+ */
+static void console_buf_drain(bool wait)
+{
+	while (console_buf_tail != console_buf_head) {
+		if (!wait && !console_buf_tx_ready())
+			return;
+
+		console_buf_write_one();
+	}
+}
+
+static int console_buf_putc(int c)
+{
+	spin_lock(&console_buf_lock);
+
+	/* Make room by waiting for a character to be written out */
+	if ((console_buf_head - console_buf_tail) == PLAT_CONSOLE_BUF_SIZE)
+		console_buf_write_one();
+
+	console_buf[console_buf_head & (PLAT_CONSOLE_BUF_SIZE - 1U)] = (char)c;
+	console_buf_head++;
+
+	console_buf_drain(false);
+
+	spin_unlock(&console_buf_lock);
+
+	return c;
+}
+#endif /* CONSOLE_BUF_ENABLED */
+
 int console_putc(int c)
 {
 	int err = ERROR_NO_VALID_CONSOLE;
 	console_t *console;
 
+#if CONSOLE_BUF_ENABLED
+	if (console_state == CONSOLE_FLAG_RUNTIME)
+		return console_buf_putc(c);
+#endif
+
 	for (console = console_list; console != NULL; console = console->next)
 		if ((console->flags & console_state) && console->putc) {
 			int ret = do_putc(c, console);
@@ -124,6 +236,12 @@ int console_flush(void)
 	int err = ERROR_NO_VALID_CONSOLE;
 	console_t *console;
 
+#if CONSOLE_BUF_ENABLED
+	spin_lock(&console_buf_lock);
+	console_buf_drain(true);
+	spin_unlock(&console_buf_lock);
+#endif
+
 	for (console = console_list; console != NULL; console = console->next)
 		if ((console->flags & console_state) && console->flush) {
 			int ret = console->flush(console);
@@ -159,6 +159,11 @@
 #define ID_AA64DFR0_PMS_SHIFT	U(32)
 #define ID_AA64DFR0_PMS_MASK	ULL(0xf)
 
+/* ID_AA64ISAR0_EL1 definitions */
+#define ID_AA64ISAR0_TLB_SHIFT	U(56)
+#define ID_AA64ISAR0_TLB_MASK	ULL(0xf)
+#define ID_AA64ISAR0_TLB_RANGE	ULL(0x2)
+
 /* ID_AA64ISAR1_EL1 definitions */
 #define ID_AA64ISAR1_EL1	S3_0_C0_C6_1
 #define ID_AA64ISAR1_GPI_SHIFT	U(28)
@@ -649,6 +654,25 @@
 #define TLBI_ADDR_MASK		ULL(0x00000FFFFFFFFFFF)
 #define TLBI_ADDR(x)		(((x) >> TLBI_ADDR_SHIFT) & TLBI_ADDR_MASK)
 
+/*
+ * Operand of the TLB range maintenance instructions (ARMv8.4-TLBI). The range
+ * covers (NUM + 1) << (5 * SCALE + 1) translation granules from BaseADDR,
+ * which is given in units of the translation granule.
+ */
+#define TLBI_RANGE_TG_SHIFT	U(46)
+#define TLBI_RANGE_TG_4K	ULL(1)
+#define TLBI_RANGE_TG_16K	ULL(2)
+#define TLBI_RANGE_TG_64K	ULL(3)
+#define TLBI_RANGE_SCALE_SHIFT	U(44)
+#define TLBI_RANGE_SCALE_MAX	U(3)
+#define TLBI_RANGE_NUM_SHIFT	U(39)
+#define TLBI_RANGE_NUM_MAX	U(31)
+#define TLBI_RANGE_BADDR_MASK	ULL(0x0000001FFFFFFFFF)
+#define TLBI_RANGE_PAGES(num, scale)	\
+	(((num) + ULL(1)) << ((5U * (scale)) + 1U))
+#define TLBI_RANGE_MAX_PAGES	TLBI_RANGE_PAGES(TLBI_RANGE_NUM_MAX, \
+						 TLBI_RANGE_SCALE_MAX)
+
 /*******************************************************************************
  * Definitions of register offsets and fields in the CNTCTLBase Frame of the
  * system level implementation of the Generic Timer.
@@ -40,6 +40,12 @@ static inline bool is_armv8_4_ttst_present(void)
 		ID_AA64MMFR2_EL1_ST_MASK) == 1U;
 }
 
+static inline bool is_armv8_4_tlbi_range_present(void)
+{
+	return ((read_id_aa64isar0_el1() >> ID_AA64ISAR0_TLB_SHIFT) &
+		ID_AA64ISAR0_TLB_MASK) >= ID_AA64ISAR0_TLB_RANGE;
+}
+
 static inline bool is_armv8_5_bti_present(void)
 {
 	return ((read_id_aa64pfr1_el1() >> ID_AA64PFR1_EL1_BT_SHIFT) &
@@ -135,6 +135,7 @@ DEFINE_SYSOP_TYPE_FUNC(tlbi, alle2is)
 DEFINE_TLBIOP_ERRATA_TYPE_FUNC(alle3)
 DEFINE_TLBIOP_ERRATA_TYPE_FUNC(alle3is)
 DEFINE_SYSOP_TYPE_FUNC(tlbi, vmalle1)
+DEFINE_SYSOP_TYPE_FUNC(tlbi, vmalle1is)
 #elif ERRATA_A76_1286807
 DEFINE_TLBIOP_ERRATA_TYPE_FUNC(alle1)
 DEFINE_TLBIOP_ERRATA_TYPE_FUNC(alle1is)
@@ -143,6 +144,7 @@ DEFINE_TLBIOP_ERRATA_TYPE_FUNC(alle2is)
 DEFINE_TLBIOP_ERRATA_TYPE_FUNC(alle3)
 DEFINE_TLBIOP_ERRATA_TYPE_FUNC(alle3is)
 DEFINE_TLBIOP_ERRATA_TYPE_FUNC(vmalle1)
+DEFINE_TLBIOP_ERRATA_TYPE_FUNC(vmalle1is)
 #else
 DEFINE_SYSOP_TYPE_FUNC(tlbi, alle1)
 DEFINE_SYSOP_TYPE_FUNC(tlbi, alle1is)
@@ -151,6 +153,7 @@ DEFINE_SYSOP_TYPE_FUNC(tlbi, alle2is)
 DEFINE_SYSOP_TYPE_FUNC(tlbi, alle3)
 DEFINE_SYSOP_TYPE_FUNC(tlbi, alle3is)
 DEFINE_SYSOP_TYPE_FUNC(tlbi, vmalle1)
+DEFINE_SYSOP_TYPE_FUNC(tlbi, vmalle1is)
 #endif
 
 #if ERRATA_A57_813419
@@ -176,6 +179,23 @@ DEFINE_SYSOP_TYPE_PARAM_FUNC(tlbi, vae3is)
 DEFINE_SYSOP_TYPE_PARAM_FUNC(tlbi, vale3is)
 #endif
 
+/*
+ * TLB range maintenance instructions (ARMv8.4-TLBI). They are encoded as SYS
+ * instructions so that they can be built with toolchains which do not support
+ * ARMv8.4. None of the CPUs affected by errata 813419 or 1286807 implement
+ * them. Use is_armv8_4_tlbi_range_present() before calling them.
+ */
+#define DEFINE_TLBIOP_RANGE_PARAM_FUNC(_type, _op1, _op2)	\
+static inline void tlbi ## _type(uint64_t v)			\
+{								\
+	__asm__("sys #" #_op1 ", c8, c2, #" #_op2 ", %0"	\
+		: : "r" (v));					\
+}
+
+DEFINE_TLBIOP_RANGE_PARAM_FUNC(rvaae1is, 0, 3)
+DEFINE_TLBIOP_RANGE_PARAM_FUNC(rvae2is, 4, 1)
+DEFINE_TLBIOP_RANGE_PARAM_FUNC(rvae3is, 6, 1)
+
 /*******************************************************************************
  * Cache maintenance accessor prototypes
  ******************************************************************************/
@@ -232,6 +252,7 @@ void disable_mmu_icache_el3(void);
 
 DEFINE_SYSREG_RW_FUNCS(par_el1)
 DEFINE_SYSREG_READ_FUNC(id_pfr1_el1)
+DEFINE_SYSREG_READ_FUNC(id_aa64isar0_el1)
 DEFINE_SYSREG_READ_FUNC(id_aa64isar1_el1)
 DEFINE_SYSREG_READ_FUNC(id_aa64pfr0_el1)
 DEFINE_SYSREG_READ_FUNC(id_aa64pfr1_el1)
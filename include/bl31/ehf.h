@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -7,6 +7,22 @@
 #ifndef EHF_H
 #define EHF_H
 
+#include <platform_def.h>
+
+/*
+ * Maximum number of handlers registered for individual interrupts, and of
+ * blocks of 32 consecutive interrupt IDs they belong to. The platform must
+ * account for its RAS interrupts and for the interrupts of the dispatchers it
+ * builds.
+ */
+#ifndef PLAT_EHF_MAX_INTR_HANDLERS
+#define PLAT_EHF_MAX_INTR_HANDLERS	U(32)
+#endif
+
+#ifndef PLAT_EHF_MAX_INTR_BLOCKS
+#define PLAT_EHF_MAX_INTR_BLOCKS	U(8)
+#endif
+
 #ifndef __ASSEMBLER__
 
 #include <cdefs.h>
@@ -65,6 +81,10 @@ typedef struct {
 typedef int (*ehf_handler_t)(uint32_t intr_raw, uint32_t flags, void *handle,
 		void *cookie);
 
+/* Handler for an individual interrupt, receiving the registered argument */
+typedef int (*ehf_intr_handler_t)(uint32_t intr_raw, uint32_t flags,
+		void *handle, void *cookie, void *arg);
+
 typedef struct ehf_pri_desc {
 	/*
 	 * 4-byte-aligned exception handler. Bit 0 indicates the corresponding
@@ -84,6 +104,8 @@ void ehf_init(void);
 void ehf_activate_priority(unsigned int priority);
 void ehf_deactivate_priority(unsigned int priority);
 void ehf_register_priority_handler(unsigned int pri, ehf_handler_t handler);
+void ehf_register_interrupt_handler(unsigned int intr,
+		ehf_intr_handler_t handler, void *arg);
 void ehf_allow_ns_preemption(uint64_t preempt_ret_code);
 unsigned int ehf_is_ns_preemption_allowed(void);
 
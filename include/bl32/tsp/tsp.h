@@ -64,11 +64,60 @@
  */
 #define TSP_FID_ABORT		TSP_FAST_FID(0x3001)
 
+/*
+ * SMC function ID to read the world switch latency statistics gathered by the
+ * TSPD when built with TSPD_LATENCY_STATS=1. It is handled by the TSPD without
+ * entering the TSP. x1 selects one of the TSP_LATENCY_* classes below and x2
+ * takes TSP_LATENCY_FLAG_* flags. The number of samples followed by the
+ * minimum, median, 99th percentile and maximum latencies in system counter
+ * ticks are returned in x1-x5.
+ */
+#define TSP_FID_LATENCY_STATS	TSP_FAST_FID(0x3002)
+
+#define TSP_LATENCY_FAST_SMC		0
+#define TSP_LATENCY_YIELD_SMC		1
+#define TSP_LATENCY_PREEMPTED_SMC	2
+#define TSP_LATENCY_SEL1_INTR		3
+#define TSP_LATENCY_NUM_CLASSES		4
+
+/* Clear the statistics of all CPUs after reading them */
+#define TSP_LATENCY_FLAG_RESET		(1 << 0)
+
+/*
+ * SMC function IDs to queue a yielding SMC to an idle cpu and to read its
+ * result, handled by the TSPD when built with TSPD_YIELD_QUEUE=1.
+ *
+ * TSP_FID_QUEUE takes the yielding function ID of the arithmetic operation in
+ * x1 and its arguments in x2-x3. It returns SMC_OK and a ticket in x1, or
+ * TSP_QUEUE_BUSY if no other cpu is idle.
+ *
+ * TSP_FID_QUEUE_RESULT takes the ticket in x1. It returns TSP_QUEUE_BUSY until
+ * the request has completed, and then the registers the yielding SMC would
+ * have returned. The ticket can only be used once.
+ */
+#define TSP_FID_QUEUE		TSP_FAST_FID(0x3003)
+#define TSP_FID_QUEUE_RESULT	TSP_FAST_FID(0x3004)
+
+#define TSP_QUEUE_BUSY		-3
+
 /*
  * Total number of function IDs implemented for services offered to NS clients.
- * The function IDs are defined above
+ * The function IDs are defined above. TSP_FID_LATENCY_STATS and the queue
+ * function IDs are only implemented when the TSPD is built with them.
  */
-#define TSP_NUM_FID		0x5
+#if TSPD_LATENCY_STATS
+#define TSP_NUM_LATENCY_FID	0x1
+#else
+#define TSP_NUM_LATENCY_FID	0x0
+#endif
+
+#if TSPD_YIELD_QUEUE
+#define TSP_NUM_QUEUE_FID	0x2
+#else
+#define TSP_NUM_QUEUE_FID	0x0
+#endif
+
+#define TSP_NUM_FID		(0x5 + TSP_NUM_LATENCY_FID + TSP_NUM_QUEUE_FID)
 
 /* TSP implementation version numbers */
 #define TSP_VERSION_MAJOR	0x0 /* Major version */
@@ -18,6 +18,9 @@
  * The format expected is the same as for printf(). For example:
  * INFO("Info %s.\n", "message")    -> INFO:    Info message.
  * WARN("Warning %s.\n", "message") -> WARNING: Warning message.
+ *
+ * When LOG_TOKENIZED is set, the messages are output in a compact encoding
+ * instead, see debug_tokenized.h.
  */
 
 #define LOG_LEVEL_NONE			U(0)
@@ -59,32 +62,42 @@
 		}					\
 	} while (false)
 
+#if LOG_TOKENIZED
+#include <common/debug_tokenized.h>
+# define tf_log_at(level, ...)	TF_LOG_TOKENIZED(level, __VA_ARGS__)
+#else
+# define tf_log_at(level, ...)	tf_log(__VA_ARGS__)
+#endif
+
 #if LOG_LEVEL >= LOG_LEVEL_ERROR
-# define ERROR(...)	tf_log(LOG_MARKER_ERROR __VA_ARGS__)
+# define ERROR(...)	tf_log_at(LOG_LEVEL_ERROR, LOG_MARKER_ERROR __VA_ARGS__)
 #else
 # define ERROR(...)	no_tf_log(LOG_MARKER_ERROR __VA_ARGS__)
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_NOTICE
-# define NOTICE(...)	tf_log(LOG_MARKER_NOTICE __VA_ARGS__)
+# define NOTICE(...)	tf_log_at(LOG_LEVEL_NOTICE,			\
+				  LOG_MARKER_NOTICE __VA_ARGS__)
 #else
 # define NOTICE(...)	no_tf_log(LOG_MARKER_NOTICE __VA_ARGS__)
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_WARNING
-# define WARN(...)	tf_log(LOG_MARKER_WARNING __VA_ARGS__)
+# define WARN(...)	tf_log_at(LOG_LEVEL_WARNING,			\
+				  LOG_MARKER_WARNING __VA_ARGS__)
 #else
 # define WARN(...)	no_tf_log(LOG_MARKER_WARNING __VA_ARGS__)
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_INFO
-# define INFO(...)	tf_log(LOG_MARKER_INFO __VA_ARGS__)
+# define INFO(...)	tf_log_at(LOG_LEVEL_INFO, LOG_MARKER_INFO __VA_ARGS__)
 #else
 # define INFO(...)	no_tf_log(LOG_MARKER_INFO __VA_ARGS__)
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_VERBOSE
-# define VERBOSE(...)	tf_log(LOG_MARKER_VERBOSE __VA_ARGS__)
+# define VERBOSE(...)	tf_log_at(LOG_LEVEL_VERBOSE,			\
+				  LOG_MARKER_VERBOSE __VA_ARGS__)
 #else
 # define VERBOSE(...)	no_tf_log(LOG_MARKER_VERBOSE __VA_ARGS__)
 #endif
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef DEBUG_TOKENIZED_H
+#define DEBUG_TOKENIZED_H
+
+#include <stdint.h>
+
+#include <cdefs.h>
+
+/*
+ * Tokenized logging, used by the log macros of debug.h when LOG_TOKENIZED=1.
+ *
+ * The format string of each log message is placed in the .tf_log_fmt section,
+ * which the linker scripts mark as not loadable, so format strings remain in
+ * the ELF file but not in the image. At runtime, only the address of the
+ * format string in that section (the token) and the raw arguments are output,
+ * and the tools/log_detokenize host tool formats the message from the ELF file.
+ *
+ * As the format string isn't available at runtime, the type of each argument
+ * is worked out at compile time: 64-bit values, strings, which are output as
+ * they are, and anything else, which is output as a 32-bit value. Up to
+ * TF_LOG_TOKENIZED_MAX_ARGS arguments are supported.
+ */
+#define TF_LOG_TOKENIZED_MAX_ARGS	16
+
+/* Types of arguments, 2 bits for each of them */
+#define TF_LOG_ARG_32			U(0)
+#define TF_LOG_ARG_64			U(1)
+#define TF_LOG_ARG_STR			U(2)
+#define TF_LOG_ARG_TYPE_BITS		U(2)
+#define TF_LOG_ARG_TYPE_MASK		U(3)
+
+#define TF_LOG_ARG_TYPE(_arg)						\
+	_Generic((_arg),						\
+		 char *: TF_LOG_ARG_STR,				\
+		 const char *: TF_LOG_ARG_STR,				\
+		 default: ((sizeof((_arg) + 0) > 4U) ? TF_LOG_ARG_64 :	\
+			   TF_LOG_ARG_32))
+
+/* Number of arguments following the format string */
+#define TF_LOG_ARG_N(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,	\
+		     _12, _13, _14, _15, _16, _n, ...)	_n
+#define TF_LOG_NARGS(...)						\
+	TF_LOG_ARG_N(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8,	\
+		     7, 6, 5, 4, 3, 2, 1, 0)
+
+/* Types of the arguments following the format string */
+#define TF_LOG_TYPES_0(...)		U(0)
+#define TF_LOG_TYPES_1(_a, ...)				\
+	(TF_LOG_ARG_TYPE(_a) | (TF_LOG_TYPES_0(__VA_ARGS__) << 2))
+#define TF_LOG_TYPES_2(_a, ...)				\
+	(TF_LOG_ARG_TYPE(_a) | (TF_LOG_TYPES_1(__VA_ARGS__) << 2))
+#define TF_LOG_TYPES_3(_a, ...)				\
+	(TF_LOG_ARG_TYPE(_a) | (TF_LOG_TYPES_2(__VA_ARGS__) << 2))
+#define TF_LOG_TYPES_4(_a, ...)				\
+	(TF_LOG_ARG_TYPE(_a) | (TF_LOG_TYPES_3(__VA_ARGS__) << 2))
+#define TF_LOG_TYPES_5(_a, ...)				\
+	(TF_LOG_ARG_TYPE(_a) | (TF_LOG_TYPES_4(__VA_ARGS__) << 2))
+#define TF_LOG_TYPES_6(_a, ...)				\
+	(TF_LOG_ARG_TYPE(_a) | (TF_LOG_TYPES_5(__VA_ARGS__) << 2))
+#define TF_LOG_TYPES_7(_a, ...)				\
+	(TF_LOG_ARG_TYPE(_a) | (TF_LOG_TYPES_6(__VA_ARGS__) << 2))
+#define TF_LOG_TYPES_8(_a, ...)				\
+	(TF_LOG_ARG_TYPE(_a) | (TF_LOG_TYPES_7(__VA_ARGS__) << 2))
+#define TF_LOG_TYPES_9(_a, ...)				\
+	(TF_LOG_ARG_TYPE(_a) | (TF_LOG_TYPES_8(__VA_ARGS__) << 2))
+#define TF_LOG_TYPES_10(_a, ...)				\
+	(TF_LOG_ARG_TYPE(_a) | (TF_LOG_TYPES_9(__VA_ARGS__) << 2))
+#define TF_LOG_TYPES_11(_a, ...)				\
+	(TF_LOG_ARG_TYPE(_a) | (TF_LOG_TYPES_10(__VA_ARGS__) << 2))
+#define TF_LOG_TYPES_12(_a, ...)				\
+	(TF_LOG_ARG_TYPE(_a) | (TF_LOG_TYPES_11(__VA_ARGS__) << 2))
+#define TF_LOG_TYPES_13(_a, ...)				\
+	(TF_LOG_ARG_TYPE(_a) | (TF_LOG_TYPES_12(__VA_ARGS__) << 2))
+#define TF_LOG_TYPES_14(_a, ...)				\
+	(TF_LOG_ARG_TYPE(_a) | (TF_LOG_TYPES_13(__VA_ARGS__) << 2))
+#define TF_LOG_TYPES_15(_a, ...)				\
+	(TF_LOG_ARG_TYPE(_a) | (TF_LOG_TYPES_14(__VA_ARGS__) << 2))
+#define TF_LOG_TYPES_16(_a, ...)				\
+	(TF_LOG_ARG_TYPE(_a) | (TF_LOG_TYPES_15(__VA_ARGS__) << 2))
+
+#define TF_LOG_CAT_(_a, _b)		_a##_b
+#define TF_LOG_CAT(_a, _b)		TF_LOG_CAT_(_a, _b)
+#define TF_LOG_TYPES(_fmt, ...)						\
+	TF_LOG_CAT(TF_LOG_TYPES_, TF_LOG_NARGS(_fmt, ##__VA_ARGS__))	\
+		(__VA_ARGS__)
+
+/*
+ * The format string is still passed to tf_log() in dead code, so that the
+ * compiler checks the arguments against it.
+ */
+#define TF_LOG_TOKENIZED(_level, _fmt, ...)				\
+	do {								\
+		static const char __tf_log_fmt[]			\
+			__section(".tf_log_fmt") = _fmt;		\
+		if (false) {						\
+			tf_log(_fmt, ##__VA_ARGS__);			\
+		}							\
+		tf_log_tokenized((_level), (uintptr_t)__tf_log_fmt,	\
+				 TF_LOG_TYPES(_fmt, ##__VA_ARGS__),	\
+				 TF_LOG_NARGS(_fmt, ##__VA_ARGS__),	\
+				 ##__VA_ARGS__);			\
+	} while (false)
+
+void tf_log_tokenized(unsigned int log_level, uintptr_t token,
+		      unsigned int types, unsigned int nargs, ...);
+
+#endif /* DEBUG_TOKENIZED_H */
@@ -22,6 +22,12 @@
 /* Constant to categorize LPI interrupt */
 #define MIN_LPI_ID		U(8192)
 
+/* GICv3.1 extended PPI and SPI ranges */
+#define MIN_EPPI_ID		U(1056)
+#define MAX_EPPI_ID		U(1119)
+#define MIN_ESPI_ID		U(4096)
+#define MAX_ESPI_ID		U(5119)
+
 /* GICv3 can only target up to 16 PEs with SGI */
 #define GICV3_MAX_SGI_TARGETS	U(16)
 
@@ -41,6 +47,23 @@
 #define GICD_IROUTER		U(0x6000)
 #define GICD_PIDR2_GICV3	U(0xffe8)
 
+/*
+ * GICv3.1 registers for the extended SPI range. Register <n>E covers the same
+ * interrupts relative to MIN_ESPI_ID as register <n> does relative to 0.
+ */
+#define GICD_IGROUPRE		U(0x1000)
+#define GICD_ISENABLERE		U(0x1200)
+#define GICD_ICENABLERE		U(0x1400)
+#define GICD_ISPENDRE		U(0x1600)
+#define GICD_ICPENDRE		U(0x1800)
+#define GICD_ISACTIVERE		U(0x1a00)
+#define GICD_ICACTIVERE		U(0x1c00)
+#define GICD_IPRIORITYRE	U(0x2000)
+#define GICD_ICFGRE		U(0x3000)
+#define GICD_IGRPMODRE		U(0x3400)
+#define GICD_NSACRE		U(0x3600)
+#define GICD_IROUTERE		U(0x8000)
+
 #define IGRPMODR_SHIFT		5
 
 /* GICD_CTLR bit definitions */
@@ -76,6 +99,13 @@
 #define GICV3_IRM_PE		U(0)
 #define GICV3_IRM_ANY		U(1)
 
+/* GICD_TYPER GICv3.1 fields */
+#define TYPER_ESPI_SHIFT	U(8)
+#define TYPER_ESPI_RANGE_SHIFT	U(27)
+#define TYPER_ESPI_RANGE_MASK	U(0x1f)
+
+#define TYPER_ESPI_BIT		BIT_32(TYPER_ESPI_SHIFT)
+
 #define NUM_OF_DIST_REGS	30
 
 /*******************************************************************************
@@ -132,6 +162,10 @@
 
 #define TYPER_LAST_BIT		BIT_32(TYPER_LAST_SHIFT)
 
+/* GICR_TYPER.PPInum, the number of EPPIs in blocks of 32 (GICv3.1) */
+#define TYPER_PPI_NUM_SHIFT	U(27)
+#define TYPER_PPI_NUM_MASK	U(0x1f)
+
 #define NUM_OF_REDIST_REGS	30
 
 /*******************************************************************************
@@ -216,6 +250,7 @@
 #include <arch_helpers.h>
 #include <common/interrupt_props.h>
 #include <drivers/arm/gic_common.h>
+#include <lib/cassert.h>
 #include <lib/utils_def.h>
 
 static inline bool gicv3_is_intr_id_special_identifier(unsigned int id)
@@ -264,6 +299,29 @@ static inline void gicv3_end_of_interrupt(unsigned int id)
 #define GICR_NUM_REGS(reg_name)	\
 	DIV_ROUND_UP_2EVAL(TOTAL_PCPU_INTR_NUM, (1 << reg_name ## _SHIFT))
 
+#if GIC_EXT_INTID
+/*
+ * Number of EPPIs and ESPIs covered by the save and restore contexts. The
+ * latter is set by the GIC_EXT_SPI_NUM build option, so that platforms only
+ * allocate context for the ESPIs they implement.
+ */
+#define TOTAL_EPPI_INTR_NUM	(MAX_EPPI_ID - MIN_EPPI_ID + U(1))
+#define TOTAL_ESPI_INTR_NUM	((unsigned int) GIC_EXT_SPI_NUM)
+
+#define GICD_NUM_EREGS(reg_name)	\
+	DIV_ROUND_UP_2EVAL(TOTAL_ESPI_INTR_NUM, (1 << reg_name ## _SHIFT))
+
+#define GICR_NUM_EREGS(reg_name)	\
+	DIV_ROUND_UP_2EVAL(TOTAL_EPPI_INTR_NUM, (1 << reg_name ## _SHIFT))
+
+/*
+ * The ESPI context is saved and restored in whole registers of 32 ESPIs, and
+ * the architecture has no more than 1024 ESPIs.
+ */
+CASSERT(((TOTAL_ESPI_INTR_NUM % 32U) == 0U) &&
+	(TOTAL_ESPI_INTR_NUM <= 1024U), assert_gic_ext_spi_num);
+#endif
+
 /* Interrupt ID mask for HPPIR, AHPPIR, IAR and AIAR CPU Interface registers */
 #define INT_ID_MASK	U(0xffffff)
 
@@ -334,11 +392,25 @@ typedef struct gicv3_redist_ctx {
 	uint32_t gicr_icfgr1;
 	uint32_t gicr_igrpmodr0;
 	uint32_t gicr_nsacr;
+
+#if GIC_EXT_INTID
+	/* Extended PPI registers */
+	uint32_t gicr_igroupr_e[GICR_NUM_EREGS(IGROUPR)];
+	uint32_t gicr_isenabler_e[GICR_NUM_EREGS(ISENABLER)];
+	uint32_t gicr_ispendr_e[GICR_NUM_EREGS(ISPENDR)];
+	uint32_t gicr_isactiver_e[GICR_NUM_EREGS(ISACTIVER)];
+	uint32_t gicr_ipriorityr_e[GICR_NUM_EREGS(IPRIORITYR)];
+	uint32_t gicr_icfgr_e[GICR_NUM_EREGS(ICFGR)];
+	uint32_t gicr_igrpmodr_e[GICR_NUM_EREGS(IGRPMODR)];
+#endif
 } gicv3_redist_ctx_t;
 
 typedef struct gicv3_dist_ctx {
 	/* 64 bits registers */
 	uint64_t gicd_irouter[TOTAL_SPI_INTR_NUM];
+#if GIC_EXT_INTID
+	uint64_t gicd_irouter_e[TOTAL_ESPI_INTR_NUM];
+#endif
 
 	/* 32 bits registers */
 	uint32_t gicd_ctlr;
@@ -350,6 +422,18 @@ typedef struct gicv3_dist_ctx {
 	uint32_t gicd_icfgr[GICD_NUM_REGS(ICFGR)];
 	uint32_t gicd_igrpmodr[GICD_NUM_REGS(IGRPMODR)];
 	uint32_t gicd_nsacr[GICD_NUM_REGS(NSACR)];
+
+#if GIC_EXT_INTID
+	/* Extended SPI registers */
+	uint32_t gicd_igroupr_e[GICD_NUM_EREGS(IGROUPR)];
+	uint32_t gicd_isenabler_e[GICD_NUM_EREGS(ISENABLER)];
+	uint32_t gicd_ispendr_e[GICD_NUM_EREGS(ISPENDR)];
+	uint32_t gicd_isactiver_e[GICD_NUM_EREGS(ISACTIVER)];
+	uint32_t gicd_ipriorityr_e[GICD_NUM_EREGS(IPRIORITYR)];
+	uint32_t gicd_icfgr_e[GICD_NUM_EREGS(ICFGR)];
+	uint32_t gicd_igrpmodr_e[GICD_NUM_EREGS(IGRPMODR)];
+	uint32_t gicd_nsacr_e[GICD_NUM_EREGS(NSACR)];
+#endif
 } gicv3_dist_ctx_t;
 
 typedef struct gicv3_its_ctx {
@@ -387,6 +471,13 @@ void gicv3_distif_save(gicv3_dist_ctx_t * const dist_ctx);
  */
 void gicv3_distif_post_restore(unsigned int proc_num);
 void gicv3_distif_pre_save(unsigned int proc_num);
+/*
+ * gicv3_distif_resets_to_zero may be implemented to report that the GIC
+ * Distributor resets the registers it saves to 0, so that
+ * gicv3_distif_init_restore can skip writing them back. The default
+ * implementation returns false.
+ */
+bool gicv3_distif_resets_to_zero(void);
 void gicv3_rdistif_init_restore(unsigned int proc_num, const gicv3_redist_ctx_t * const rdist_ctx);
 void gicv3_rdistif_save(unsigned int proc_num, gicv3_redist_ctx_t * const rdist_ctx);
 void gicv3_its_save_disable(uintptr_t gits_base, gicv3_its_ctx_t * const its_ctx);
@@ -396,6 +487,8 @@ unsigned int gicv3_get_running_priority(void);
 unsigned int gicv3_get_interrupt_active(unsigned int id, unsigned int proc_num);
 void gicv3_enable_interrupt(unsigned int id, unsigned int proc_num);
 void gicv3_disable_interrupt(unsigned int id, unsigned int proc_num);
+void gicv3_enable_spi_range(unsigned int id, unsigned int num);
+void gicv3_disable_spi_range(unsigned int id, unsigned int num);
 void gicv3_set_interrupt_priority(unsigned int id, unsigned int proc_num,
 		unsigned int priority);
 void gicv3_set_interrupt_type(unsigned int id, unsigned int proc_num,
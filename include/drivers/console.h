@@ -14,7 +14,8 @@
 #define CONSOLE_T_PUTC			(U(2) * REGSZ)
 #define CONSOLE_T_GETC			(U(3) * REGSZ)
 #define CONSOLE_T_FLUSH			(U(4) * REGSZ)
-#define CONSOLE_T_DRVDATA		(U(5) * REGSZ)
+#define CONSOLE_T_TX_READY		(U(5) * REGSZ)
+#define CONSOLE_T_DRVDATA		(U(6) * REGSZ)
 
 #define CONSOLE_FLAG_BOOT		(U(1) << 0)
 #define CONSOLE_FLAG_RUNTIME		(U(1) << 1)
@@ -29,6 +30,14 @@
 /* Returned by console_xxx() if no registered console implements xxx. */
 #define ERROR_NO_VALID_CONSOLE		(-128)
 
+/* Only the EL3 runtime images have a runtime console state to buffer */
+#if CONSOLE_BUFFERED && \
+	(defined(IMAGE_BL31) || (!defined(__aarch64__) && defined(IMAGE_BL32)))
+#define CONSOLE_BUF_ENABLED		1
+#else
+#define CONSOLE_BUF_ENABLED		0
+#endif
+
 #ifndef __ASSEMBLER__
 
 #include <stdint.h>
@@ -43,6 +52,11 @@ typedef struct console {
 	int (*const putc)(int character, struct console *console);
 	int (*const getc)(struct console *console);
 	int (*const flush)(struct console *console);
+	/*
+	 * Optional. Returns 1 if putc can output a character without waiting
+	 * for the transmit FIFO to drain, 0 otherwise.
+	 */
+	int (*const tx_ready)(struct console *console);
 	/* Additional private driver data may follow here. */
 } console_t;
 
@@ -73,7 +87,10 @@ void console_switch_state(unsigned int new_state);
 int console_putc(int c);
 /* Read a character (blocking) from any console registered for current state. */
 int console_getc(void);
-/* Flush all consoles registered for the current state. */
+/*
+ * Flush all consoles registered for the current state, after writing out any
+ * output still buffered with CONSOLE_BUFFERED.
+ */
 int console_flush(void);
 
 #endif /* __ASSEMBLER__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -23,6 +23,8 @@ CASSERT(CONSOLE_T_GETC == __builtin_offsetof(console_t, getc),
 	assert_console_t_getc_offset_mismatch);
 CASSERT(CONSOLE_T_FLUSH == __builtin_offsetof(console_t, flush),
 	assert_console_t_flush_offset_mismatch);
+CASSERT(CONSOLE_T_TX_READY == __builtin_offsetof(console_t, tx_ready),
+	assert_console_t_tx_ready_offset_mismatch);
 CASSERT(CONSOLE_T_DRVDATA == sizeof(console_t),
 	assert_console_t_drvdata_offset_mismatch);
 
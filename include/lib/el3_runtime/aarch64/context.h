@@ -140,6 +140,22 @@
  */
 #define CTX_SYSREGS_END		CTX_MTE_REGS_END
 
+/*
+ * Optional groups of EL1 system registers. With CTX_EL1_SYSREGS_GROUPS, a
+ * group is only switched between security states if the Secure payload
+ * declared that it uses it. The remaining EL1 system registers are always
+ * switched, subject to the NS_TIMER_SWITCH and CTX_INCLUDE_MTE_REGS build
+ * options.
+ */
+#define CTX_SYSREGS_GRP_EL0_BIT		U(0)	/* TPIDR_EL0, TPIDRRO_EL0 */
+#define CTX_SYSREGS_GRP_FAULT_BIT	U(1)	/* PAR_EL1, FAR_EL1, AFSR{0,1}_EL1 */
+#define CTX_SYSREGS_GRP_AARCH32_BIT	U(2)	/* AArch32 banked registers */
+
+#define CTX_SYSREGS_GRP_EL0		(U(1) << CTX_SYSREGS_GRP_EL0_BIT)
+#define CTX_SYSREGS_GRP_FAULT		(U(1) << CTX_SYSREGS_GRP_FAULT_BIT)
+#define CTX_SYSREGS_GRP_AARCH32		(U(1) << CTX_SYSREGS_GRP_AARCH32_BIT)
+#define CTX_SYSREGS_GRP_ALL		U(0x7)
+
 /*******************************************************************************
  * Constants that allow assembler code to access members of and the 'fp_regs'
  * structure at their correct offsets.
@@ -387,8 +403,8 @@ CASSERT(CTX_PAUTH_REGS_OFFSET == __builtin_offsetof(cpu_context_t, pauth_ctx), \
 /*******************************************************************************
  * Function prototypes
  ******************************************************************************/
-void el1_sysregs_context_save(el1_sys_regs_t *regs);
-void el1_sysregs_context_restore(el1_sys_regs_t *regs);
+void el1_sysregs_context_save(el1_sys_regs_t *regs, unsigned int groups);
+void el1_sysregs_context_restore(el1_sys_regs_t *regs, unsigned int groups);
 #if CTX_INCLUDE_FPREGS
 void fpregs_context_save(fp_regs_t *regs);
 void fpregs_context_restore(fp_regs_t *regs);
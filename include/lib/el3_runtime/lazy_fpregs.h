@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef LAZY_FPREGS_H
+#define LAZY_FPREGS_H
+
+#include <stdint.h>
+
+/*
+ * Per-CPU, per-security state counters maintained when CTX_LAZY_FPREGS is
+ * enabled.
+ *
+ * 'world_entries' counts the entries into the security state through the
+ * context management library. 'fp_switches' counts the number of times the
+ * FP/SIMD register file had to be loaded with the state of that security
+ * state, i.e. for the Secure world the number of entries that actually used
+ * FP/SIMD, and for the Non-secure world the number of times its registers
+ * had to be reloaded after the Secure world used them.
+ */
+typedef struct lazy_fpregs_stats {
+	uint64_t world_entries;
+	uint64_t fp_switches;
+} lazy_fpregs_stats_t;
+
+void lazy_fpregs_trap_handler(void);
+void lazy_fpregs_get_stats(unsigned int cpu_idx, uint32_t security_state,
+			   lazy_fpregs_stats_t *stats);
+
+#endif /* LAZY_FPREGS_H */
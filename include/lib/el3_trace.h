@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef EL3_TRACE_H
+#define EL3_TRACE_H
+
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+#include <tools_share/el3_trace.h>
+
+/*
+ * Per-CPU trace of the events handled by BL31, for reconstructing what EL3 did
+ * around a latency spike. Each CPU records events in its own fixed size ring
+ * of records, overwriting the oldest ones, without taking any lock. The format
+ * of the records is shared with the host decoder in tools/el3_trace.
+ *
+ * Trace points use EL3_TRACE_EVENT(), which compiles to nothing unless BL31 is
+ * built with EL3_TRACE=1.
+ */
+#if EL3_TRACE && defined(IMAGE_BL31)
+
+void el3_trace_record(unsigned int event, u_register_t arg0,
+		      u_register_t arg1);
+void el3_trace_world_switch(unsigned int security_state);
+uintptr_t el3_trace_read_smc(void *handle, u_register_t flags,
+			     u_register_t cpu, u_register_t seq);
+
+/* Called from the BL31 SMC handler */
+void el3_trace_smc_entry(uint32_t smc_fid, u_register_t x1);
+void el3_trace_smc_exit(uint32_t smc_fid);
+
+#define EL3_TRACE_EVENT(_event, _arg0, _arg1)				\
+	el3_trace_record((_event), (u_register_t)(_arg0),		\
+			 (u_register_t)(_arg1))
+
+#else
+
+static inline void el3_trace_world_switch(unsigned int security_state)
+{
+}
+
+#define EL3_TRACE_EVENT(_event, _arg0, _arg1)
+
+#endif /* EL3_TRACE && defined(IMAGE_BL31) */
+
+#endif /* EL3_TRACE_H */
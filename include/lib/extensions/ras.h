@@ -59,10 +59,13 @@
  * their handlers.
  *
  * This macro must be used in the same file as the array of interrupts are
- * declared. Only then would ARRAY_SIZE() yield a meaningful value. Also, the
- * array is expected to be sorted in the increasing order of interrupt number.
+ * declared. Only then would ARRAY_SIZE() yield a meaningful value. Each
+ * interrupt uses one of the PLAT_EHF_MAX_INTR_HANDLERS handlers of EHF, which
+ * is checked at build time.
  */
 #define REGISTER_RAS_INTERRUPTS(_array) \
+	CASSERT(ARRAY_SIZE(_array) <= PLAT_EHF_MAX_INTR_HANDLERS, \
+		assert_ras_interrupts_exceed_ehf_handlers); \
 	const struct ras_interrupt_mapping ras_interrupt_mappings = { \
 		.intrs = (_array), \
 		.num_intrs = ARRAY_SIZE(_array), \
@@ -72,6 +75,8 @@
 
 #include <assert.h>
 
+#include <bl31/ehf.h>
+#include <lib/cassert.h>
 #include <lib/extensions/ras_arch.h>
 
 struct err_record_info;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -7,9 +7,38 @@
 #ifndef SVE_H
 #define SVE_H
 
+#include <lib/utils_def.h>
+
+/*
+ * Layout of the SVE register context saved by sve_regs_context_save(). The
+ * registers are stored at the vector length selected by ZCR_EL3, so the
+ * structure is sized for the architectural maximum of 2048 bits. The
+ * predicate registers and FFR come first as they are a fixed fraction of the
+ * vector length.
+ */
+#define SVE_VL_MAX_BYTES	U(256)
+#define SVE_PL_MAX_BYTES	(SVE_VL_MAX_BYTES >> 3)
+#define SVE_CTX_PREGS_OFFSET	U(0)
+#define SVE_CTX_FFR_INDEX	U(16)
+#define SVE_CTX_ZREGS_OFFSET	(U(17) * SVE_PL_MAX_BYTES)
+#define SVE_CTX_END		(SVE_CTX_ZREGS_OFFSET + (U(32) * SVE_VL_MAX_BYTES))
+
+#ifndef __ASSEMBLER__
+
+#include <cdefs.h>
 #include <stdbool.h>
+#include <stdint.h>
+
+typedef struct sve_regs {
+	uint8_t regs[SVE_CTX_END];
+} __aligned(16) sve_regs_t;
 
 bool sve_supported(void);
 void sve_enable(bool el2_unused);
 
+void sve_regs_context_save(sve_regs_t *regs);
+void sve_regs_context_restore(sve_regs_t *regs);
+
+#endif /* __ASSEMBLER__ */
+
 #endif /* SVE_H */
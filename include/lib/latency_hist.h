@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef LATENCY_HIST_H
+#define LATENCY_HIST_H
+
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * Fixed size histogram of latencies, typically expressed in system counter
+ * ticks.
+ *
+ * Samples are sorted into log-linear buckets: every power of two range is split
+ * into LATENCY_HIST_SUB_BUCKETS equal buckets, so the relative error of the
+ * percentiles derived from the histogram is bounded by 1/LATENCY_HIST_SUB_BUCKETS
+ * regardless of the magnitude of the samples. Samples of
+ * 2^LATENCY_HIST_MAX_SHIFT ticks or more all land in the last bucket; 'max'
+ * still records their exact value.
+ *
+ * The histogram is not protected against concurrent updates. Users keep one
+ * instance per CPU and merge them when reporting.
+ */
+#define LATENCY_HIST_SUB_SHIFT		U(2)
+#define LATENCY_HIST_SUB_BUCKETS	(U(1) << LATENCY_HIST_SUB_SHIFT)
+#define LATENCY_HIST_MAX_SHIFT		U(24)
+#define LATENCY_HIST_BUCKETS		\
+	((LATENCY_HIST_MAX_SHIFT - LATENCY_HIST_SUB_SHIFT + U(1)) *	\
+	 LATENCY_HIST_SUB_BUCKETS)
+
+typedef struct latency_hist {
+	uint64_t count;
+	uint64_t min;
+	uint64_t max;
+	uint64_t sum;
+	uint32_t buckets[LATENCY_HIST_BUCKETS];
+} latency_hist_t;
+
+void latency_hist_reset(latency_hist_t *hist);
+void latency_hist_record(latency_hist_t *hist, uint64_t ticks);
+void latency_hist_merge(latency_hist_t *dst, const latency_hist_t *src);
+uint64_t latency_hist_percentile(const latency_hist_t *hist, unsigned int pct);
+
+#endif /* LATENCY_HIST_H */
@@ -30,6 +30,7 @@ typedef struct spd_pm_ops {
 	int32_t (*svc_migrate_info)(u_register_t *resident_cpu);
 	void (*svc_system_off)(void);
 	void (*svc_system_reset)(void);
+	void (*svc_on_finish_unlocked)(void);
 } spd_pm_ops_t;
 
 /*
@@ -16,6 +16,8 @@
 #define SPRT_MSG_TYPE_SERVICE_HANDLE_CLOSE		2
 /* TODO: Add other types of SPRT messages. */
 #define SPRT_MSG_TYPE_SERVICE_TUN_REQUEST		10
+#define SPRT_MSG_TYPE_SERVICE_RING_DOORBELL		11
+#define SPRT_MSG_TYPE_SERVICE_RING_REQUEST		12
 
 /*
  * Struct that defines the layout of the fields corresponding to a request in
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2019, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SPRT_RING_H
+#define SPRT_RING_H
+
+#include <stdint.h>
+
+#include "sprt_common.h"
+
+/*
+ * Layout of a ring of requests and responses in Non-secure memory, registered
+ * by a client with SPCI_SERVICE_RING_REGISTER and mapped in the partition that
+ * provides the service. SPM doesn't access it, the client and the partition
+ * exchange requests and responses through it directly.
+ *
+ * The request entries are followed by as many response entries. Indices are
+ * free-running and wrap at 2^32, an index refers to the entry at the index
+ * modulo entry_num. Each index is only written by one side: the client writes
+ * req_prod and rsp_cons, the partition writes req_cons and rsp_prod. Entries
+ * must be visible before the index that publishes them is written.
+ */
+struct __attribute__((__packed__)) sprt_ring_entry {
+	uint32_t token;		/* Chosen by the client, copied to the response */
+	uint32_t session_id;	/* Optional SPCI session ID */
+	uint64_t args[SPRT_MAX_MSG_ARGS];
+};
+
+struct __attribute__((__packed__)) sprt_ring {
+	uint32_t entry_num;	/* Number of entries of each ring, power of 2 */
+	uint32_t req_prod;	/* Index of the next request to be written */
+	uint32_t req_cons;	/* Index of the next request to be read */
+	uint32_t rsp_prod;	/* Index of the next response to be written */
+	uint32_t rsp_cons;	/* Index of the next response to be read */
+	uint32_t reserved[3];
+	struct sprt_ring_entry entries[0];
+};
+
+/* Size of a ring with the given number of entries in each direction */
+#define SPRT_RING_SIZE(entry_num)	(sizeof(struct sprt_ring) +	\
+			(2U * (entry_num) * sizeof(struct sprt_ring_entry)))
+
+#endif /* SPRT_RING_H */
@@ -185,10 +185,20 @@
 	INTR_PROP_DESC(ARM_IRQ_SEC_SGI_7, GIC_HIGHEST_SEC_PRIORITY, (grp), \
 			GIC_INTR_CFG_EDGE)
 
+/*
+ * With TSPD_YIELD_QUEUE=1, the TSPD uses SGI 6 to queue yielding SMCs to other
+ * cpus, at its own priority level.
+ */
+#if TSPD_YIELD_QUEUE
+#define ARM_IRQ_SEC_SGI_6_PRI		PLAT_TSPD_QUEUE_PRI
+#else
+#define ARM_IRQ_SEC_SGI_6_PRI		GIC_HIGHEST_SEC_PRIORITY
+#endif
+
 #define ARM_G0_IRQ_PROPS(grp) \
 	INTR_PROP_DESC(ARM_IRQ_SEC_SGI_0, PLAT_SDEI_NORMAL_PRI, (grp), \
 			GIC_INTR_CFG_EDGE), \
-	INTR_PROP_DESC(ARM_IRQ_SEC_SGI_6, GIC_HIGHEST_SEC_PRIORITY, (grp), \
+	INTR_PROP_DESC(ARM_IRQ_SEC_SGI_6, ARM_IRQ_SEC_SGI_6_PRI, (grp), \
 			GIC_INTR_CFG_EDGE)
 
 #define ARM_MAP_SHARED_RAM		MAP_REGION_FLAT(		\
@@ -534,6 +544,7 @@
 #define PLAT_RAS_PRI			0x10
 #define PLAT_SDEI_CRITICAL_PRI		0x60
 #define PLAT_SDEI_NORMAL_PRI		0x70
+#define PLAT_TSPD_QUEUE_PRI		0x50
 
 /* ARM platforms use 3 upper bits of secure interrupt priority */
 #define ARM_PRI_BITS			3
@@ -541,6 +552,9 @@
 /* SGI used for SDEI signalling */
 #define ARM_SDEI_SGI			ARM_IRQ_SEC_SGI_0
 
+/* SGI used by the TSPD to queue yielding SMCs to other cpus */
+#define PLAT_TSPD_QUEUE_SGI		ARM_IRQ_SEC_SGI_6
+
 /* ARM SDEI dynamic private event numbers */
 #define ARM_SDEI_DP_EVENT_0		1000
 #define ARM_SDEI_DP_EVENT_1		1001
@@ -551,11 +565,23 @@
 #define ARM_SDEI_DS_EVENT_1		2001
 #define ARM_SDEI_DS_EVENT_2		2002
 
+#if TSPD_YIELD_QUEUE
+/* ARM SDEI explicit event notifying the completion of queued yielding SMCs */
+#define ARM_SDEI_TSPD_QUEUE_EVENT	3000
+#define PLAT_TSPD_QUEUE_SDEI_EVENT	ARM_SDEI_TSPD_QUEUE_EVENT
+
+#define ARM_SDEI_TSPD_QUEUE_EVENTS \
+	, SDEI_EXPLICIT_EVENT(ARM_SDEI_TSPD_QUEUE_EVENT, SDEI_MAPF_NORMAL)
+#else
+#define ARM_SDEI_TSPD_QUEUE_EVENTS
+#endif
+
 #define ARM_SDEI_PRIVATE_EVENTS \
 	SDEI_DEFINE_EVENT_0(ARM_SDEI_SGI), \
 	SDEI_PRIVATE_EVENT(ARM_SDEI_DP_EVENT_0, SDEI_DYN_IRQ, SDEI_MAPF_DYNAMIC), \
 	SDEI_PRIVATE_EVENT(ARM_SDEI_DP_EVENT_1, SDEI_DYN_IRQ, SDEI_MAPF_DYNAMIC), \
-	SDEI_PRIVATE_EVENT(ARM_SDEI_DP_EVENT_2, SDEI_DYN_IRQ, SDEI_MAPF_DYNAMIC)
+	SDEI_PRIVATE_EVENT(ARM_SDEI_DP_EVENT_2, SDEI_DYN_IRQ, SDEI_MAPF_DYNAMIC) \
+	ARM_SDEI_TSPD_QUEUE_EVENTS
 
 #define ARM_SDEI_SHARED_EVENTS \
 	SDEI_SHARED_EVENT(ARM_SDEI_DS_EVENT_0, SDEI_DYN_IRQ, SDEI_MAPF_DYNAMIC), \
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -19,6 +19,18 @@
 /* Function ID for requesting state switch of lower EL */
 #define ARM_SIP_SVC_EXE_STATE_SWITCH	U(0x82000020)
 
+/* Function ID for reading the SDEI dispatch latency statistics */
+#define ARM_SIP_SVC_SDEI_LATENCY_STATS	U(0xC2000021)
+
+/* Function ID for reading a record of the EL3 event trace */
+#define ARM_SIP_SVC_EL3_TRACE_READ	U(0xC2000022)
+
+/* Function ID for reading the OP-TEE dispatcher world switch counters */
+#define ARM_SIP_SVC_OPTEED_SWITCH_STATS	U(0xC2000023)
+
+/* Function ID for reading the Trusty dispatcher FIQ latency statistics */
+#define ARM_SIP_SVC_TRUSTY_FIQ_LATENCY	U(0xC2000024)
+
 /* ARM SiP Service Calls version numbers */
 #define ARM_SIP_SVC_VERSION_MAJOR		U(0x0)
 #define ARM_SIP_SVC_VERSION_MINOR		U(0x2)
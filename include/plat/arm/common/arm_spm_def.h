@@ -32,6 +32,12 @@
 #define PLAT_SPM_HEAP_BASE	(PLAT_SP_PACKAGE_BASE + PLAT_SP_PACKAGE_SIZE)
 #define PLAT_SPM_HEAP_SIZE	(BL32_LIMIT - BL32_BASE - PLAT_SP_PACKAGE_SIZE)
 
+/*
+ * The heap is 2MB aligned, so let SPM skip heap memory to map the regions of
+ * the partitions with 2MB blocks where possible.
+ */
+#define PLAT_SPM_HEAP_BLOCK_ALIGN	1
+
 #if SPM_MM
 
 /*
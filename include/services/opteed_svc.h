@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef OPTEED_SVC_H
+#define OPTEED_SVC_H
+
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * Entries into OP-TEE counted by the OPTEED when built with
+ * OPTEED_SWITCH_STATS=1, and read through opteed_switch_stats_smc().
+ *
+ * A yielding call starts a new request, for example the invocation of a
+ * Trusted Application, and each of its RPCs to the normal world is resumed
+ * with a OPTEE_SMC_RETURN_FROM_RPC call.
+ */
+#define OPTEED_SWITCH_YIELD_CALL	U(0)
+#define OPTEED_SWITCH_RPC_RETURN	U(1)
+#define OPTEED_SWITCH_FAST_CALL		U(2)
+#define OPTEED_SWITCH_FIQ		U(3)
+#define OPTEED_SWITCH_NUM_TYPES		U(4)
+
+/* Clear the counters of all cpus after reading them */
+#define OPTEED_SWITCH_FLAG_RESET	U(1)
+
+#if OPTEED_SWITCH_STATS
+/* Handler for a platform SMC reporting the OPTEED world switch counters */
+uintptr_t opteed_switch_stats_smc(void *handle, u_register_t flags);
+#endif
+
+#endif /* OPTEED_SVC_H */
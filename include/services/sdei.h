@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -41,6 +41,28 @@
 #define SDEI_EV_HANDLED		0U
 #define SDEI_EV_FAILED		1U
 
+/*
+ * SDEI dispatch latency statistics, gathered when built with
+ * SDEI_LATENCY_STATS=1 and read through sdei_latency_stats_smc().
+ *
+ * Classes of events, matching the SDEI event priorities.
+ */
+#define SDEI_LATENCY_NORMAL		U(0)
+#define SDEI_LATENCY_CRITICAL		U(1)
+#define SDEI_LATENCY_NUM_CLASSES	U(2)
+
+/*
+ * Measured intervals: from the entry into the SDEI interrupt handler to the
+ * dispatch of the event to the client, and from that dispatch to the client
+ * completing the event.
+ */
+#define SDEI_LATENCY_DISPATCH		U(0)
+#define SDEI_LATENCY_HANDLER		U(1)
+#define SDEI_LATENCY_NUM_METRICS	U(2)
+
+/* Clear the statistics of all PEs after reading them */
+#define SDEI_LATENCY_FLAG_RESET		U(1)
+
 /* Internal: SDEI flag bit positions */
 #define SDEI_MAPF_DYNAMIC_SHIFT_	1U
 #define SDEI_MAPF_BOUND_SHIFT_		2U
@@ -180,4 +202,10 @@ void sdei_init(void);
 /* Public API to dispatch an event to Normal world */
 int sdei_dispatch_event(int ev_num);
 
+#if SDEI_LATENCY_STATS
+/* Handler for a platform SMC reporting the SDEI dispatch latency statistics */
+uintptr_t sdei_latency_stats_smc(void *handle, u_register_t ev_class,
+		u_register_t metric, u_register_t flags);
+#endif
+
 #endif /* SDEI_H */
@@ -111,6 +111,9 @@ struct sp_rd_sect_mem_region {
 	 *   - 5: SPM-to-SP Shared Memory Region
 	 *   - 6: Client Shared Memory Region
 	 *   - 7: Miscellaneous
+	 *   - 8: Client Ring Region. Only reserves the VA range where SPM
+	 *     maps the request rings registered by clients, no memory is
+	 *     allocated for it.
 	 * - If memory is { SPM-to-SP shared Memory, Client Shared Memory,
 	 *   Miscellaneous }
 	 *   - bits[4]: Position Independent
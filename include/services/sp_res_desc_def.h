@@ -44,6 +44,7 @@
 #define RD_MEM_NORMAL_SPM_SP_SHARED_MEM	U(5)
 #define RD_MEM_NORMAL_CLIENT_SHARED_MEM	U(6)
 #define RD_MEM_NORMAL_MISCELLANEOUS	U(7)
+#define RD_MEM_NORMAL_CLIENT_RINGS	U(8)
 
 #define RD_MEM_MASK			U(15)
 
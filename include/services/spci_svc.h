@@ -64,6 +64,9 @@
 #define SPCI_FID_SERVICE_REQUEST_START		U(0x8)
 #define SPCI_FID_SERVICE_GET_RESPONSE		U(0x9)
 #define SPCI_FID_SERVICE_RESET_CLIENT_STATE	U(0xA)
+#define SPCI_FID_SERVICE_RING_REGISTER		U(0xB)
+#define SPCI_FID_SERVICE_RING_DOORBELL		U(0xC)
+#define SPCI_FID_SERVICE_RING_REQUEST_BLOCKING	U(0xD)
 
 /* SPCI tunneling functions */
 
@@ -101,6 +104,14 @@
 #define SPCI_SERVICE_RESET_CLIENT_STATE_AARCH32	SPCI_MISC_32(SPCI_FID_SERVICE_RESET_CLIENT_STATE)
 #define SPCI_SERVICE_RESET_CLIENT_STATE_AARCH64	SPCI_MISC_64(SPCI_FID_SERVICE_RESET_CLIENT_STATE)
 
+#define SPCI_SERVICE_RING_REGISTER_AARCH64	SPCI_MISC_64(SPCI_FID_SERVICE_RING_REGISTER)
+
+#define SPCI_SERVICE_RING_DOORBELL_AARCH32	SPCI_MISC_32(SPCI_FID_SERVICE_RING_DOORBELL)
+#define SPCI_SERVICE_RING_DOORBELL_AARCH64	SPCI_MISC_64(SPCI_FID_SERVICE_RING_DOORBELL)
+
+#define SPCI_SERVICE_RING_REQUEST_BLOCKING_AARCH32 SPCI_MISC_32(SPCI_FID_SERVICE_RING_REQUEST_BLOCKING)
+#define SPCI_SERVICE_RING_REQUEST_BLOCKING_AARCH64 SPCI_MISC_64(SPCI_FID_SERVICE_RING_REQUEST_BLOCKING)
+
 #define SPCI_SERVICE_TUN_REQUEST_START_AARCH32	SPCI_TUN_32(SPCI_FID_SERVICE_TUN_REQUEST_START)
 #define SPCI_SERVICE_TUN_REQUEST_START_AARCH64	SPCI_TUN_64(SPCI_FID_SERVICE_TUN_REQUEST_START)
 
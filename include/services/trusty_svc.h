@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef TRUSTY_SVC_H
+#define TRUSTY_SVC_H
+
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * Intervals timed by the Trusty dispatcher when built with
+ * TRUSTY_FIQ_LATENCY_STATS=1, and read through trusty_fiq_latency_stats_smc().
+ *
+ * TRUSTY_FIQ_LATENCY_ENTRY goes from the FIQ of the normal world reaching the
+ * dispatcher until the return to the FIQ handler of the normal world, and
+ * TRUSTY_FIQ_LATENCY_EXIT from SMC_FC_FIQ_EXIT until the return to the code
+ * interrupted by the FIQ.
+ */
+#define TRUSTY_FIQ_LATENCY_ENTRY	U(0)
+#define TRUSTY_FIQ_LATENCY_EXIT		U(1)
+#define TRUSTY_FIQ_LATENCY_NUM_CLASSES	U(2)
+
+/* Clear the statistics of all cpus after reading them */
+#define TRUSTY_FIQ_LATENCY_FLAG_RESET	U(1)
+
+#if TRUSTY_FIQ_LATENCY_STATS
+/* Handler for a platform SMC reporting the Trusty FIQ latency statistics */
+uintptr_t trusty_fiq_latency_stats_smc(void *handle, u_register_t type,
+				       u_register_t flags);
+#endif
+
+#endif /* TRUSTY_SVC_H */
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2019, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef EL3_TRACE_FORMAT_H
+#define EL3_TRACE_FORMAT_H
+
+#include <stdint.h>
+
+/*
+ * Format of the records of the EL3 event trace, shared between BL31 and the
+ * host tool decoding them. Records are little-endian, 32 bytes each.
+ */
+
+/* Event types, and the meaning of their arguments */
+#define EL3_TRACE_EV_NONE		0	/* No record */
+#define EL3_TRACE_EV_SMC_ENTRY		1	/* FID, x1 */
+#define EL3_TRACE_EV_SMC_EXIT		2	/* FID, 0 */
+#define EL3_TRACE_EV_INTR		3	/* Interrupt type, pending ID */
+#define EL3_TRACE_EV_WORLD_SWITCH	4	/* Security state, previous one */
+#define EL3_TRACE_EV_PSCI		5	/* EL3_TRACE_PSCI_*, power level */
+#define EL3_TRACE_EV_SDEI_DISPATCH	6	/* Event number, interrupt ID */
+#define EL3_TRACE_NUM_EVENTS		7
+
+/* PSCI state transitions recorded by EL3_TRACE_EV_PSCI */
+#define EL3_TRACE_PSCI_SUSPEND		0
+#define EL3_TRACE_PSCI_OFF		1
+#define EL3_TRACE_PSCI_ON_FINISH	2
+#define EL3_TRACE_PSCI_SUSPEND_FINISH	3
+
+struct el3_trace_record {
+	/* System counter value when the event occurred */
+	uint64_t timestamp;
+	uint64_t arg0;
+	uint64_t arg1;
+	/* Low 32 bits of the index of the record in the ring of its CPU */
+	uint32_t seq;
+	uint16_t event;
+	/* Linear index of the CPU, as returned by plat_my_core_pos() */
+	uint16_t cpu;
+};
+
+#endif /* EL3_TRACE_FORMAT_H */
@@ -18,6 +18,7 @@
 #include <context.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/el3_runtime/pubsub_events.h>
+#include <lib/el3_trace.h>
 #include <lib/extensions/amu.h>
 #include <lib/extensions/mpam.h>
 #include <lib/extensions/spe.h>
@@ -26,6 +27,12 @@
 #include <plat/common/platform.h>
 #include <smccc_helpers.h>
 
+/*
+ * Optional EL1 system register groups switched by
+ * cm_el1_sysregs_context_{save,restore}(). Only honoured when
+ * CTX_EL1_SYSREGS_GROUPS is enabled.
+ */
+static unsigned int el1_sysregs_groups = CTX_SYSREGS_GRP_ALL;
 
 /*******************************************************************************
  * Context management library initialisation routine. This library is used by
@@ -255,6 +262,28 @@ void cm_setup_context(cpu_context_t *ctx, const entry_point_info_t *ep)
 	memcpy(gp_regs, (void *)&ep->args, sizeof(aapcs64_params_t));
 }
 
+/*******************************************************************************
+ * Restore the EL1 system registers of the given security state, including the
+ * optional register groups in 'groups', and notify the subscribers that this
+ * security state is being entered.
+ ******************************************************************************/
+static void el1_sysregs_restore(uint32_t security_state, unsigned int groups)
+{
+	cpu_context_t *ctx;
+
+	ctx = cm_get_context(security_state);
+	assert(ctx != NULL);
+
+	el1_sysregs_context_restore(get_sysregs_ctx(ctx), groups);
+
+#if IMAGE_BL31
+	if (security_state == SECURE)
+		PUBLISH_EVENT(cm_entering_secure_world);
+	else
+		PUBLISH_EVENT(cm_entering_normal_world);
+#endif
+}
+
 /*******************************************************************************
  * Enable architecture extensions on first entry to Non-secure world.
  * When EL2 is implemented but unused `el2_unused` is non-zero, otherwise
@@ -518,10 +547,28 @@ void cm_prepare_el3_exit(uint32_t security_state)
 		enable_extensions_nonsecure(el2_unused);
 	}
 
-	cm_el1_sysregs_context_restore(security_state);
+	/*
+	 * This is the first entry into the security state since the CPU was
+	 * powered up, so all the optional register groups are restored.
+	 */
+	el1_sysregs_restore(security_state, CTX_SYSREGS_GRP_ALL);
 	cm_set_next_eret_context(security_state);
 }
 
+/*******************************************************************************
+ * This function declares the optional EL1 system register groups used by the
+ * Secure payload. When CTX_EL1_SYSREGS_GROUPS is enabled, only these groups are
+ * switched on subsequent calls to cm_el1_sysregs_context_{save,restore}() for
+ * either security state; registers of the other groups are left untouched by
+ * both worlds. The mandatory EL1 system registers are always switched.
+ ******************************************************************************/
+void cm_el1_sysregs_set_groups(unsigned int groups)
+{
+	assert((groups & ~CTX_SYSREGS_GRP_ALL) == 0U);
+
+	el1_sysregs_groups = groups;
+}
+
 /*******************************************************************************
  * The next four functions are used by runtime services to save and restore
  * EL1 context on the 'cpu_context' structure for the specified security
@@ -534,7 +581,7 @@ void cm_el1_sysregs_context_save(uint32_t security_state)
 	ctx = cm_get_context(security_state);
 	assert(ctx != NULL);
 
-	el1_sysregs_context_save(get_sysregs_ctx(ctx));
+	el1_sysregs_context_save(get_sysregs_ctx(ctx), el1_sysregs_groups);
 
 #if IMAGE_BL31
 	if (security_state == SECURE)
@@ -546,19 +593,7 @@ void cm_el1_sysregs_context_save(uint32_t security_state)
 
 void cm_el1_sysregs_context_restore(uint32_t security_state)
 {
-	cpu_context_t *ctx;
-
-	ctx = cm_get_context(security_state);
-	assert(ctx != NULL);
-
-	el1_sysregs_context_restore(get_sysregs_ctx(ctx));
-
-#if IMAGE_BL31
-	if (security_state == SECURE)
-		PUBLISH_EVENT(cm_entering_secure_world);
-	else
-		PUBLISH_EVENT(cm_entering_normal_world);
-#endif
+	el1_sysregs_restore(security_state, el1_sysregs_groups);
 }
 
 /*******************************************************************************
@@ -659,5 +694,7 @@ void cm_set_next_eret_context(uint32_t security_state)
 	ctx = cm_get_context(security_state);
 	assert(ctx != NULL);
 
+	el3_trace_world_switch(security_state);
+
 	cm_set_next_context(ctx);
 }
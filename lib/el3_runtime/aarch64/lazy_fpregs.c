@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+
+#include <platform_def.h>
+
+#include <arch.h>
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <context.h>
+#include <lib/el3_runtime/context_mgmt.h>
+#include <lib/el3_runtime/lazy_fpregs.h>
+#include <lib/el3_runtime/pubsub_events.h>
+#include <lib/extensions/sve.h>
+#include <plat/common/platform.h>
+
+/*
+ * Lazy FP/SIMD context switching.
+ *
+ * Outside of Secure world execution the live FP/SIMD registers (and the SVE
+ * registers aliasing them when ENABLE_SVE_FOR_NS is set) always hold the
+ * Non-secure state. Entering the Secure world sets CPTR_EL3.TFP so that its
+ * first FP/SIMD access traps to EL3, where the Non-secure registers are saved
+ * and the Secure ones restored. When the Secure world is left again, the
+ * Non-secure registers are put back only if the Secure world used FP/SIMD.
+ *
+ * Keeping the Non-secure state live while EL3 runs means that nothing needs
+ * to be flushed before a CPU is powered down.
+ */
+struct lazy_fp_ctx {
+	/* The live FP/SIMD registers hold the Secure world state */
+	bool secure_live;
+
+	/* Counters indexed by security state */
+	lazy_fpregs_stats_t stats[2];
+};
+
+static struct lazy_fp_ctx lazy_fp_ctxs[PLATFORM_CORE_COUNT];
+
+#if ENABLE_SVE_FOR_NS
+static sve_regs_t ns_sve_regs[PLATFORM_CORE_COUNT];
+#endif
+
+/*
+ * Allow EL3 to access the FP/SIMD registers and, if the Non-secure SVE state
+ * needs to be switched, the SVE registers. CPTR_EL3 traps accesses from EL3
+ * as well as from the lower ELs.
+ */
+static bool lazy_fpregs_enable_access(void)
+{
+	uint64_t cptr = read_cptr_el3() & ~TFP_BIT;
+	bool sve = false;
+
+#if ENABLE_SVE_FOR_NS
+	if (sve_supported()) {
+		cptr |= CPTR_EZ_BIT;
+		sve = true;
+	}
+#endif
+	write_cptr_el3(cptr);
+	isb();
+
+	return sve;
+}
+
+static void lazy_fpregs_save_ns(unsigned int core_pos, bool sve)
+{
+	fpregs_context_save(get_fpregs_ctx(cm_get_context(NON_SECURE)));
+
+#if ENABLE_SVE_FOR_NS
+	if (sve)
+		sve_regs_context_save(&ns_sve_regs[core_pos]);
+#endif
+}
+
+static void lazy_fpregs_restore_ns(unsigned int core_pos, bool sve)
+{
+	fpregs_context_restore(get_fpregs_ctx(cm_get_context(NON_SECURE)));
+
+	/* The SVE restore overwrites the Z registers aliasing the V ones */
+#if ENABLE_SVE_FOR_NS
+	if (sve)
+		sve_regs_context_restore(&ns_sve_regs[core_pos]);
+#endif
+}
+
+/*
+ * Handler for FP/SIMD accesses trapped by CPTR_EL3.TFP. Called from the
+ * runtime exception vectors with the general purpose registers of the
+ * trapping context saved. Returning to the lower EL re-executes the trapped
+ * instruction.
+ */
+void lazy_fpregs_trap_handler(void)
+{
+	unsigned int core_pos = plat_my_core_pos();
+	struct lazy_fp_ctx *ctx = &lazy_fp_ctxs[core_pos];
+	bool sve;
+
+	if ((read_scr_el3() & SCR_NS_BIT) != 0U) {
+		/*
+		 * The Non-secure state is always live outside of Secure world
+		 * execution. Just remove the trap.
+		 */
+		write_cptr_el3(read_cptr_el3() & ~TFP_BIT);
+		return;
+	}
+
+	if (ctx->secure_live) {
+		ERROR("Unexpected Secure FP/SIMD trap\n");
+		panic();
+	}
+
+	sve = lazy_fpregs_enable_access();
+	lazy_fpregs_save_ns(core_pos, sve);
+	fpregs_context_restore(get_fpregs_ctx(cm_get_context(SECURE)));
+
+	ctx->secure_live = true;
+	ctx->stats[SECURE].fp_switches++;
+
+	/* SVE remains disabled for the Secure world */
+	write_cptr_el3(read_cptr_el3() & ~CPTR_EZ_BIT);
+}
+
+static void *lazy_fpregs_enter_secure(const void *arg)
+{
+	struct lazy_fp_ctx *ctx = &lazy_fp_ctxs[plat_my_core_pos()];
+	uint64_t cptr = read_cptr_el3() & ~CPTR_EZ_BIT;
+
+	ctx->stats[SECURE].world_entries++;
+
+	/*
+	 * Trap the first FP/SIMD access of the Secure world unless its
+	 * registers are already live.
+	 */
+	if (ctx->secure_live)
+		cptr &= ~TFP_BIT;
+	else
+		cptr |= TFP_BIT;
+
+	write_cptr_el3(cptr);
+
+	/*
+	 * No explicit ISB required here as ERET to switch to Secure
+	 * world covers it
+	 */
+	return (void *)0;
+}
+
+/*
+ * Hand the FP/SIMD registers back to the Non-secure world if the Secure world
+ * used them.
+ */
+static void lazy_fpregs_release_secure(unsigned int core_pos)
+{
+	struct lazy_fp_ctx *ctx = &lazy_fp_ctxs[core_pos];
+	bool sve;
+
+	if (!ctx->secure_live)
+		return;
+
+	sve = lazy_fpregs_enable_access();
+	fpregs_context_save(get_fpregs_ctx(cm_get_context(SECURE)));
+	lazy_fpregs_restore_ns(core_pos, sve);
+
+	ctx->secure_live = false;
+	ctx->stats[NON_SECURE].fp_switches++;
+}
+
+static void *lazy_fpregs_exit_secure(const void *arg)
+{
+	lazy_fpregs_release_secure(plat_my_core_pos());
+
+	return (void *)0;
+}
+
+static void *lazy_fpregs_enter_normal(const void *arg)
+{
+	unsigned int core_pos = plat_my_core_pos();
+
+	/*
+	 * Some dispatchers return to the Non-secure world without saving the
+	 * Secure context, e.g. after S-EL1 interrupt handling.
+	 */
+	lazy_fpregs_release_secure(core_pos);
+
+	lazy_fp_ctxs[core_pos].stats[NON_SECURE].world_entries++;
+
+	write_cptr_el3(read_cptr_el3() & ~TFP_BIT);
+
+	/*
+	 * No explicit ISB required here as ERET to switch to Non-secure
+	 * world covers it
+	 */
+	return (void *)0;
+}
+
+void lazy_fpregs_get_stats(unsigned int cpu_idx, uint32_t security_state,
+			   lazy_fpregs_stats_t *stats)
+{
+	assert(cpu_idx < PLATFORM_CORE_COUNT);
+	assert(sec_state_is_valid(security_state));
+	assert(stats != NULL);
+
+	*stats = lazy_fp_ctxs[cpu_idx].stats[security_state];
+}
+
+SUBSCRIBE_TO_EVENT(cm_entering_secure_world, lazy_fpregs_enter_secure);
+SUBSCRIBE_TO_EVENT(cm_exited_secure_world, lazy_fpregs_exit_secure);
+SUBSCRIBE_TO_EVENT(cm_entering_normal_world, lazy_fpregs_enter_normal);
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*******************************************************************************
+ * Per-CPU EL3 event trace. Each CPU only ever writes to its own ring, and EL3
+ * runs with interrupts masked, so recording an event needs no lock. Readers on
+ * other CPUs rely on the sequence number of each record, written last, to
+ * detect records being overwritten while they are copied.
+ ******************************************************************************/
+#include <assert.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <common/runtime_svc.h>
+#include <lib/cassert.h>
+#include <lib/el3_trace.h>
+#include <plat/common/platform.h>
+
+/* Number of records in the ring of each CPU. Must be a power of 2 */
+#ifndef PLAT_EL3_TRACE_ENTRIES
+#define PLAT_EL3_TRACE_ENTRIES		U(128)
+#endif
+
+CASSERT((PLAT_EL3_TRACE_ENTRIES & (PLAT_EL3_TRACE_ENTRIES - 1U)) == 0U,
+	assert_el3_trace_entries_not_power_of_2);
+
+#define EL3_TRACE_IDX_MASK		(PLAT_EL3_TRACE_ENTRIES - 1U)
+
+/* Sequence number of a record being written */
+#define EL3_TRACE_SEQ_INVALID		U(0xffffffff)
+
+typedef struct el3_trace_ring {
+	/* Number of records written since boot */
+	uint64_t head;
+
+	/* Security state of the last context prepared for ERET */
+	unsigned int security_state;
+
+	struct el3_trace_record rec[PLAT_EL3_TRACE_ENTRIES];
+} __aligned(CACHE_WRITEBACK_GRANULE) el3_trace_ring_t;
+
+static el3_trace_ring_t el3_trace_rings[PLATFORM_CORE_COUNT];
+
+void el3_trace_record(unsigned int event, u_register_t arg0,
+		      u_register_t arg1)
+{
+	unsigned int cpu = plat_my_core_pos();
+	el3_trace_ring_t *ring = &el3_trace_rings[cpu];
+	uint64_t idx = ring->head;
+	struct el3_trace_record *rec = &ring->rec[idx & EL3_TRACE_IDX_MASK];
+
+	assert(event < EL3_TRACE_NUM_EVENTS);
+
+	/* Invalidate the record before updating it */
+	rec->seq = EL3_TRACE_SEQ_INVALID;
+	dmbish();
+
+	rec->timestamp = read_cntpct_el0();
+	rec->arg0 = arg0;
+	rec->arg1 = arg1;
+	rec->event = (uint16_t)event;
+	rec->cpu = (uint16_t)cpu;
+
+	/* Publish the record */
+	dmbish();
+	rec->seq = (uint32_t)idx;
+	ring->head = idx + 1U;
+}
+
+void el3_trace_smc_entry(uint32_t smc_fid, u_register_t x1)
+{
+	el3_trace_record(EL3_TRACE_EV_SMC_ENTRY, smc_fid, x1);
+}
+
+void el3_trace_smc_exit(uint32_t smc_fid)
+{
+	el3_trace_record(EL3_TRACE_EV_SMC_EXIT, smc_fid, 0U);
+}
+
+/* Record a change of the security state the next ERET returns to */
+void el3_trace_world_switch(unsigned int security_state)
+{
+	el3_trace_ring_t *ring = &el3_trace_rings[plat_my_core_pos()];
+
+	if (ring->security_state == security_state)
+		return;
+
+	el3_trace_record(EL3_TRACE_EV_WORLD_SWITCH, security_state,
+			 ring->security_state);
+	ring->security_state = security_state;
+}
+
+/*******************************************************************************
+ * Report the record with index 'seq' in the ring of 'cpu', or the oldest one
+ * still in the ring if it has been overwritten. x1 holds the index of the
+ * record returned, x2 its timestamp, x3 its event type, and x4-x5 its
+ * arguments. If no record has been written at 'seq' yet, the event type is
+ * EL3_TRACE_EV_NONE and x1 holds the index of the next record to be written.
+ *
+ * The records reveal what the Secure world does, so only Secure callers may
+ * read them unless the build enables EL3_TRACE_NS_READ.
+ ******************************************************************************/
+uintptr_t el3_trace_read_smc(void *handle, u_register_t flags,
+			     u_register_t cpu, u_register_t seq)
+{
+	const el3_trace_ring_t *ring;
+	struct el3_trace_record rec;
+	uint64_t head;
+
+	if ((EL3_TRACE_NS_READ == 0) && is_caller_non_secure(flags))
+		SMC_RET1(handle, SMC_UNK);
+
+	if (cpu >= PLATFORM_CORE_COUNT)
+		SMC_RET1(handle, SMC_UNK);
+
+	ring = &el3_trace_rings[cpu];
+
+	for (;;) {
+		head = *(volatile const uint64_t *)&ring->head;
+		dmbish();
+
+		if (seq >= head)
+			SMC_RET6(handle, SMC_OK, head, 0U, EL3_TRACE_EV_NONE,
+				 0U, 0U);
+
+		if ((head - seq) > PLAT_EL3_TRACE_ENTRIES)
+			seq = head - PLAT_EL3_TRACE_ENTRIES;
+
+		rec = ring->rec[seq & EL3_TRACE_IDX_MASK];
+		dmbish();
+
+		/* Retry if the writer has started overwriting the record */
+		if ((rec.seq == (uint32_t)seq) &&
+		    (*(volatile const uint32_t *)
+				&ring->rec[seq & EL3_TRACE_IDX_MASK].seq ==
+				(uint32_t)seq))
+			break;
+	}
+
+	SMC_RET6(handle, SMC_OK, seq, rec.timestamp, rec.event, rec.arg0,
+		 rec.arg1);
+}
@@ -57,34 +57,16 @@ int ras_ea_handler(unsigned int ea_reason, uint64_t syndrome, void *cookie,
 	return (n_handled != 0U) ? 1 : 0;
 }
 
-#if ENABLE_ASSERTIONS
-static void assert_interrupts_sorted(void)
-{
-	unsigned int i, last;
-	struct ras_interrupt *start = ras_interrupt_mappings.intrs;
-
-	if (ras_interrupt_mappings.num_intrs == 0UL)
-		return;
-
-	last = start[0].intr_number;
-	for (i = 1; i < ras_interrupt_mappings.num_intrs; i++) {
-		assert(start[i].intr_number > last);
-		last = start[i].intr_number;
-	}
-}
-#endif
-
 /*
- * Given an RAS interrupt number, locate the registered handler and call it. If
- * no handler was found for the interrupt number, this function panics.
+ * Handler for a RAS interrupt, registered with EHF for each entry of the
+ * platform's interrupt mappings. 'arg' points to the corresponding mapping.
  */
 static int ras_interrupt_handler(uint32_t intr_raw, uint32_t flags,
-		void *handle, void *cookie)
+		void *handle, void *cookie, void *arg)
 {
-	struct ras_interrupt *ras_inrs = ras_interrupt_mappings.intrs;
-	struct ras_interrupt *selected = NULL;
+	struct ras_interrupt *selected = arg;
 	int probe_data = 0;
-	int start, end, mid, ret __unused;
+	int ret __unused;
 
 	const struct err_handler_data err_data = {
 		.version = ERR_HANDLER_VERSION,
@@ -94,28 +76,8 @@ static int ras_interrupt_handler(uint32_t intr_raw, uint32_t flags,
 		.handle = handle
 	};
 
-	assert(ras_interrupt_mappings.num_intrs > 0UL);
-
-	start = 0;
-	end = (int) ras_interrupt_mappings.num_intrs;
-	while (start <= end) {
-		mid = ((end + start) / 2);
-		if (intr_raw == ras_inrs[mid].intr_number) {
-			selected = &ras_inrs[mid];
-			break;
-		} else if (intr_raw < ras_inrs[mid].intr_number) {
-			/* Move left */
-			end = mid - 1;
-		} else {
-			/* Move right */
-			start = mid + 1;
-		}
-	}
-
-	if (selected == NULL) {
-		ERROR("RAS interrupt %u has no handler!\n", intr_raw);
-		panic();
-	}
+	assert(selected != NULL);
+	assert(selected->intr_number == intr_raw);
 
 	if (selected->err_record->probe != NULL) {
 		ret = selected->err_record->probe(selected->err_record, &probe_data);
@@ -132,11 +94,15 @@ static int ras_interrupt_handler(uint32_t intr_raw, uint32_t flags,
 
 void __init ras_init(void)
 {
-#if ENABLE_ASSERTIONS
-	/* Check RAS interrupts are sorted */
-	assert_interrupts_sorted();
-#endif
-
-	/* Register RAS priority handler */
-	ehf_register_priority_handler(PLAT_RAS_PRI, ras_interrupt_handler);
+	struct ras_interrupt *intrs = ras_interrupt_mappings.intrs;
+	unsigned int i;
+
+	/*
+	 * Register a handler for each RAS interrupt, so that EHF dispatches
+	 * them directly to the error record they belong to.
+	 */
+	for (i = 0U; i < ras_interrupt_mappings.num_intrs; i++) {
+		ehf_register_interrupt_handler(intrs[i].intr_number,
+				ras_interrupt_handler, &intrs[i]);
+	}
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -72,9 +72,11 @@ void sve_enable(bool el2_unused)
 	if (!sve_supported())
 		return;
 
-#if CTX_INCLUDE_FPREGS
+#if CTX_INCLUDE_FPREGS && !CTX_LAZY_FPREGS
 	/*
-	 * CTX_INCLUDE_FPREGS is not supported on SVE enabled systems.
+	 * CTX_INCLUDE_FPREGS is not supported on SVE enabled systems, unless
+	 * the lazy switching, which preserves the Non-secure SVE registers,
+	 * is used.
 	 */
 	assert(0);
 #endif
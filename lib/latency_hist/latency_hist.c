@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <lib/latency_hist.h>
+
+/* Sub-bucket resolution of the power of two range starting at 2^shift */
+#define SUB_MASK	(LATENCY_HIST_SUB_BUCKETS - U(1))
+
+static unsigned int latency_hist_bucket(uint64_t ticks)
+{
+	unsigned int msb;
+
+	/* The smallest values have a bucket each */
+	if (ticks < LATENCY_HIST_SUB_BUCKETS)
+		return (unsigned int)ticks;
+
+	if (ticks >= (ULL(1) << LATENCY_HIST_MAX_SHIFT))
+		return LATENCY_HIST_BUCKETS - U(1);
+
+	msb = 63U - (unsigned int)__builtin_clzll(ticks);
+
+	return ((msb - LATENCY_HIST_SUB_SHIFT + U(1)) *
+		LATENCY_HIST_SUB_BUCKETS) +
+	       ((unsigned int)(ticks >> (msb - LATENCY_HIST_SUB_SHIFT)) &
+		SUB_MASK);
+}
+
+/* Return the largest value sorted into the given bucket */
+static uint64_t latency_hist_bucket_limit(unsigned int idx)
+{
+	unsigned int shift;
+	uint64_t base;
+
+	if (idx < LATENCY_HIST_SUB_BUCKETS)
+		return idx;
+
+	shift = (idx / LATENCY_HIST_SUB_BUCKETS) - U(1);
+	base = (uint64_t)(LATENCY_HIST_SUB_BUCKETS + (idx & SUB_MASK)) << shift;
+
+	return base + (ULL(1) << shift) - 1U;
+}
+
+void latency_hist_reset(latency_hist_t *hist)
+{
+	assert(hist != NULL);
+
+	(void)memset(hist, 0, sizeof(*hist));
+	hist->min = UINT64_MAX;
+}
+
+void latency_hist_record(latency_hist_t *hist, uint64_t ticks)
+{
+	assert(hist != NULL);
+
+	/* A zeroed histogram is valid as well as a reset one */
+	if ((hist->count == 0U) || (ticks < hist->min))
+		hist->min = ticks;
+	if (ticks > hist->max)
+		hist->max = ticks;
+
+	hist->count++;
+	hist->sum += ticks;
+	hist->buckets[latency_hist_bucket(ticks)]++;
+}
+
+void latency_hist_merge(latency_hist_t *dst, const latency_hist_t *src)
+{
+	unsigned int i;
+
+	assert((dst != NULL) && (src != NULL));
+
+	if (src->count == 0U)
+		return;
+
+	if ((dst->count == 0U) || (src->min < dst->min))
+		dst->min = src->min;
+	if (src->max > dst->max)
+		dst->max = src->max;
+
+	dst->count += src->count;
+	dst->sum += src->sum;
+
+	for (i = 0U; i < LATENCY_HIST_BUCKETS; i++)
+		dst->buckets[i] += src->buckets[i];
+}
+
+/*
+ * Return an upper bound of the 'pct' percentile of the recorded samples, or 0
+ * if the histogram is empty. The result is exact for the 0th and 100th
+ * percentiles.
+ */
+uint64_t latency_hist_percentile(const latency_hist_t *hist, unsigned int pct)
+{
+	uint64_t rank, seen = 0U, limit;
+	unsigned int i;
+
+	assert(hist != NULL);
+	assert(pct <= 100U);
+
+	if (hist->count == 0U)
+		return 0U;
+
+	if (pct == 0U)
+		return hist->min;
+
+	/* Rank of the sample, rounded up, in the sorted list of samples */
+	rank = ((hist->count * pct) + 99U) / 100U;
+
+	for (i = 0U; i < LATENCY_HIST_BUCKETS; i++) {
+		seen += hist->buckets[i];
+		if (seen >= rank)
+			break;
+	}
+
+	if (i == LATENCY_HIST_BUCKETS)
+		return hist->max;
+
+	limit = latency_hist_bucket_limit(i);
+	if (limit > hist->max)
+		limit = hist->max;
+	if (limit < hist->min)
+		limit = hist->min;
+
+	return limit;
+}
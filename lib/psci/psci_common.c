@@ -13,6 +13,7 @@
 #include <common/debug.h>
 #include <context.h>
 #include <lib/el3_runtime/context_mgmt.h>
+#include <lib/el3_trace.h>
 #include <lib/utils.h>
 #include <plat/common/platform.h>
 
@@ -768,6 +769,7 @@ void psci_warmboot_entrypoint(void)
 	unsigned int cpu_idx = plat_my_core_pos();
 	unsigned int parent_nodes[PLAT_MAX_PWR_LVL] = {0};
 	psci_power_state_t state_info = { {PSCI_LOCAL_STATE_RUN} };
+	bool cpu_on = false;
 
 	/*
 	 * Verify that we have been explicitly turned ON or resumed from
@@ -812,10 +814,16 @@ void psci_warmboot_entrypoint(void)
 	 * of power management handler and perform the generic, architecture
 	 * and platform specific handling.
 	 */
-	if (psci_get_aff_info_state() == AFF_STATE_ON_PENDING)
+	if (psci_get_aff_info_state() == AFF_STATE_ON_PENDING) {
+		EL3_TRACE_EVENT(EL3_TRACE_EV_PSCI, EL3_TRACE_PSCI_ON_FINISH,
+				end_pwrlvl);
 		psci_cpu_on_finish(cpu_idx, &state_info);
-	else
+		cpu_on = true;
+	} else {
+		EL3_TRACE_EVENT(EL3_TRACE_EV_PSCI,
+				EL3_TRACE_PSCI_SUSPEND_FINISH, end_pwrlvl);
 		psci_cpu_suspend_finish(cpu_idx, &state_info);
+	}
 
 	/*
 	 * Set the requested and target state of this CPU and all the higher
@@ -838,6 +846,14 @@ void psci_warmboot_entrypoint(void)
 	 * in the reverse order to which they were acquired.
 	 */
 	psci_release_pwr_domain_locks(end_pwrlvl, parent_nodes);
+
+	/*
+	 * Let the Secure Payload Dispatcher do the work which shouldn't be
+	 * done while holding the power domain locks.
+	 */
+	if (cpu_on && (psci_spd_pm != NULL) &&
+	    (psci_spd_pm->svc_on_finish_unlocked != NULL))
+		psci_spd_pm->svc_on_finish_unlocked();
 }
 
 /*******************************************************************************
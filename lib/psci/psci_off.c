@@ -10,6 +10,7 @@
 #include <arch.h>
 #include <arch_helpers.h>
 #include <common/debug.h>
+#include <lib/el3_trace.h>
 #include <lib/pmf/pmf.h>
 #include <lib/runtime_instr.h>
 #include <plat/common/platform.h>
@@ -53,6 +54,8 @@ int psci_do_cpu_off(unsigned int end_pwrlvl)
 	 */
 	assert(psci_plat_pm_ops->pwr_domain_off != NULL);
 
+	EL3_TRACE_EVENT(EL3_TRACE_EV_PSCI, EL3_TRACE_PSCI_OFF, end_pwrlvl);
+
 	/* Construct the psci_power_state for CPU_OFF */
 	psci_set_power_off_state(&state_info);
 
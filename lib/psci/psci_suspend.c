@@ -15,6 +15,7 @@
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/el3_runtime/cpu_data.h>
 #include <lib/el3_runtime/pubsub_events.h>
+#include <lib/el3_trace.h>
 #include <lib/pmf/pmf.h>
 #include <lib/runtime_instr.h>
 #include <plat/common/platform.h>
@@ -167,6 +168,8 @@ void psci_cpu_suspend_start(const entry_point_info_t *ep,
 	assert((psci_plat_pm_ops->pwr_domain_suspend != NULL) &&
 	       (psci_plat_pm_ops->pwr_domain_suspend_finish != NULL));
 
+	EL3_TRACE_EVENT(EL3_TRACE_EV_PSCI, EL3_TRACE_PSCI_SUSPEND, end_pwrlvl);
+
 	/* Get the parent nodes */
 	psci_get_parent_pwr_domain_nodes(idx, end_pwrlvl, parent_nodes);
 
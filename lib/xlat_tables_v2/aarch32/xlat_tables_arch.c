@@ -102,6 +102,39 @@ void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
 	}
 }
 
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime)
+{
+	uintptr_t end_va = va + size;
+
+	assert(IS_PAGE_ALIGNED(va) && IS_PAGE_ALIGNED(size));
+
+	/*
+	 * Ensure the translation table writes have drained into memory before
+	 * invalidating the TLB entries.
+	 */
+	dsbishst();
+
+	/* There are no TLB range operations in AArch32 state */
+	if ((size >> PAGE_SIZE_SHIFT) > PLAT_XLAT_TLBI_VA_MAX_PAGES) {
+		if (xlat_regime == EL1_EL0_REGIME) {
+			tlbiallis();
+		} else {
+			assert(xlat_regime == EL2_REGIME);
+			tlbiallhis();
+		}
+		return;
+	}
+
+	for (; va < end_va; va += PAGE_SIZE) {
+		if (xlat_regime == EL1_EL0_REGIME) {
+			tlbimvaais(TLBI_ADDR(va));
+		} else {
+			assert(xlat_regime == EL2_REGIME);
+			tlbimvahis(TLBI_ADDR(va));
+		}
+	}
+}
+
 void xlat_arch_tlbi_va_sync(void)
 {
 	/* Invalidate all entries from branch predictors. */
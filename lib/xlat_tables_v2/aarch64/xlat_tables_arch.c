@@ -157,21 +157,17 @@ uint64_t xlat_arch_regime_get_xn_desc(int xlat_regime)
 	}
 }
 
-void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
+/*
+ * Invalidate the TLB entries of one page, without any barrier.
+ *
+ * This function only supports invalidation of TLB entries for the EL3, EL2 and
+ * EL1&0 translation regimes.
+ *
+ * Also, it is architecturally UNDEFINED to invalidate TLBs of a higher
+ * exception level (see section D4.9.2 of the ARM ARM rev B.a).
+ */
+static void tlbi_va_page(uintptr_t va, int xlat_regime)
 {
-	/*
-	 * Ensure the translation table write has drained into memory before
-	 * invalidating the TLB entry.
-	 */
-	dsbishst();
-
-	/*
-	 * This function only supports invalidation of TLB entries for the EL3
-	 * and EL1&0 translation regimes.
-	 *
-	 * Also, it is architecturally UNDEFINED to invalidate TLBs of a higher
-	 * exception level (see section D4.9.2 of the ARM ARM rev B.a).
-	 */
 	if (xlat_regime == EL1_EL0_REGIME) {
 		assert(xlat_arch_current_el() >= 1U);
 		tlbivaae1is(TLBI_ADDR(va));
@@ -185,6 +181,107 @@ void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
 	}
 }
 
+/* Invalidate all the TLB entries of a translation regime */
+static void tlbi_regime(int xlat_regime)
+{
+	if (xlat_regime == EL1_EL0_REGIME) {
+		assert(xlat_arch_current_el() >= 1U);
+		tlbivmalle1is();
+	} else if (xlat_regime == EL2_REGIME) {
+		assert(xlat_arch_current_el() >= 2U);
+		tlbialle2is();
+	} else {
+		assert(xlat_regime == EL3_REGIME);
+		assert(xlat_arch_current_el() >= 3U);
+		tlbialle3is();
+	}
+}
+
+/*
+ * Invalidate 'pages' pages from 'va' with ARMv8.4-TLBI range operations. Each
+ * operation covers (NUM + 1) << (5 * SCALE + 1) pages, so an odd page is
+ * invalidated on its own and the rest is split into at most one operation per
+ * SCALE value. This requires pages < TLBI_RANGE_MAX_PAGES.
+ */
+CASSERT(PAGE_SIZE == PAGE_SIZE_4KB, assert_tlbi_range_granule_is_4kb);
+
+static void tlbi_va_range_armv8_4(uintptr_t va, u_register_t pages,
+				  int xlat_regime)
+{
+	u_register_t num, op, range_pages;
+	unsigned int scale = 0U;
+
+	assert(pages < TLBI_RANGE_MAX_PAGES);
+
+	if ((pages & 1U) != 0U) {
+		tlbi_va_page(va, xlat_regime);
+		va += PAGE_SIZE;
+		pages--;
+	}
+
+	while (pages != 0U) {
+		assert(scale <= TLBI_RANGE_SCALE_MAX);
+
+		num = (pages >> ((5U * scale) + 1U)) & TLBI_RANGE_NUM_MAX;
+		if (num != 0U) {
+			range_pages = TLBI_RANGE_PAGES(num - 1U, scale);
+
+			op = (TLBI_RANGE_TG_4K << TLBI_RANGE_TG_SHIFT) |
+			     ((u_register_t)scale << TLBI_RANGE_SCALE_SHIFT) |
+			     ((num - 1U) << TLBI_RANGE_NUM_SHIFT) |
+			     ((va >> PAGE_SIZE_SHIFT) & TLBI_RANGE_BADDR_MASK);
+
+			if (xlat_regime == EL1_EL0_REGIME) {
+				tlbirvaae1is(op);
+			} else if (xlat_regime == EL2_REGIME) {
+				tlbirvae2is(op);
+			} else {
+				assert(xlat_regime == EL3_REGIME);
+				tlbirvae3is(op);
+			}
+
+			va += range_pages << PAGE_SIZE_SHIFT;
+			pages -= range_pages;
+		}
+
+		scale++;
+	}
+}
+
+void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
+{
+	/*
+	 * Ensure the translation table write has drained into memory before
+	 * invalidating the TLB entry.
+	 */
+	dsbishst();
+
+	tlbi_va_page(va, xlat_regime);
+}
+
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime)
+{
+	u_register_t pages = size >> PAGE_SIZE_SHIFT;
+	uintptr_t end_va = va + size;
+
+	assert(IS_PAGE_ALIGNED(va) && IS_PAGE_ALIGNED(size));
+
+	/*
+	 * Ensure the translation table writes have drained into memory before
+	 * invalidating the TLB entries.
+	 */
+	dsbishst();
+
+	if ((pages < TLBI_RANGE_MAX_PAGES) && is_armv8_4_tlbi_range_present()) {
+		tlbi_va_range_armv8_4(va, pages, xlat_regime);
+	} else if (pages > PLAT_XLAT_TLBI_VA_MAX_PAGES) {
+		tlbi_regime(xlat_regime);
+	} else {
+		for (; va < end_va; va += PAGE_SIZE)
+			tlbi_va_page(va, xlat_regime);
+	}
+}
+
 void xlat_arch_tlbi_va_sync(void)
 {
 	/*
@@ -340,7 +340,8 @@ static action_t xlat_tables_unmap_region_action(const mmap_region_t *mm,
 }
 /*
  * Recursive function that writes to the translation tables and unmaps the
- * specified region.
+ * specified region. The caller must invalidate the TLB entries of the whole
+ * region afterwards, which also covers any removed subtable.
  */
 static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 				     const uintptr_t table_base_va,
@@ -377,7 +378,6 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 		if (action == ACTION_WRITE_BLOCK_ENTRY) {
 
 			table_base[table_idx] = INVALID_DESC;
-			xlat_arch_tlbi_va(table_idx_va, ctx->xlat_regime);
 
 		} else if (action == ACTION_RECURSE_INTO_TABLE) {
 
@@ -396,8 +396,6 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 			 */
 			if (xlat_table_is_empty(ctx, subtable)) {
 				table_base[table_idx] = INVALID_DESC;
-				xlat_arch_tlbi_va(table_idx_va,
-						  ctx->xlat_regime);
 			}
 
 		} else {
@@ -1028,6 +1026,10 @@ int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 			xlat_clean_dcache_range((uintptr_t)ctx->base_table,
 				ctx->base_table_entries * sizeof(uint64_t));
 #endif
+			xlat_arch_tlbi_va_range(unmap_mm.base_va, unmap_mm.size,
+						ctx->xlat_regime);
+			xlat_arch_tlbi_va_sync();
+
 			return -ENOMEM;
 		}
 
@@ -1114,6 +1116,8 @@ int mmap_remove_dynamic_region_ctx(xlat_ctx_t *ctx, uintptr_t base_va,
 		xlat_clean_dcache_range((uintptr_t)ctx->base_table,
 			ctx->base_table_entries * sizeof(uint64_t));
 #endif
+		xlat_arch_tlbi_va_range(mm->base_va, mm->size,
+					ctx->xlat_regime);
 		xlat_arch_tlbi_va_sync();
 	}
 
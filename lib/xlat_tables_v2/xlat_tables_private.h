@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -38,6 +38,14 @@
 
 #endif /* PLAT_XLAT_TABLES_DYNAMIC */
 
+/*
+ * Largest number of pages invalidated one at a time by
+ * xlat_arch_tlbi_va_range() when the TLB range operations are not available.
+ */
+#ifndef PLAT_XLAT_TLBI_VA_MAX_PAGES
+#define PLAT_XLAT_TLBI_VA_MAX_PAGES	U(64)
+#endif
+
 extern uint64_t mmu_cfg_params[MMU_CFG_PARAM_MAX];
 
 /*
@@ -59,9 +67,19 @@ uint64_t xlat_arch_regime_get_xn_desc(int xlat_regime);
  */
 void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime);
 
+/*
+ * Invalidate all TLB entries that match a virtual address in the page aligned
+ * range [va, va + size), with the same scope as xlat_arch_tlbi_va(). The range
+ * is invalidated with ARMv8.4-TLBI range operations if the PE supports them.
+ * Otherwise, ranges of more than PLAT_XLAT_TLBI_VA_MAX_PAGES pages invalidate
+ * all TLB entries of the translation regime instead, which is cheaper than
+ * invalidating them one page at a time.
+ */
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime);
+
 /*
  * This function has to be called at the end of any code that uses the function
- * xlat_arch_tlbi_va().
+ * xlat_arch_tlbi_va() or xlat_arch_tlbi_va_range().
  */
 void xlat_arch_tlbi_va_sync(void);
 
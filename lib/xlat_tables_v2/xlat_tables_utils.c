@@ -20,6 +20,12 @@
 
 #include "xlat_tables_private.h"
 
+/*
+ * Valid bit of a translation table descriptor. A descriptor with this bit
+ * cleared is invalid, whatever the value of its other bits.
+ */
+#define XLAT_DESC_VALID			ULL(0x1)
+
 #if LOG_LEVEL < LOG_LEVEL_VERBOSE
 
 void xlat_mmap_print(__unused const mmap_region_t *mmap)
@@ -259,12 +265,17 @@ void xlat_tables_print(xlat_ctx_t *ctx)
  *   Number of entries in the translation table for the initial lookup level.
  * virt_addr_space_size
  *   Size in bytes of the virtual address space.
+ * invalid_page_ok
+ *   Also accept a page descriptor with only its valid bit cleared at the final
+ *   lookup level, as left by xlat_change_mem_attributes_ctx() during its
+ *   break-before-make sequence.
  */
-static uint64_t *find_xlat_table_entry(uintptr_t virtual_addr,
-				       void *xlat_table_base,
-				       unsigned int xlat_table_base_entries,
-				       unsigned long long virt_addr_space_size,
-				       unsigned int *out_level)
+static uint64_t *xlat_table_walk(uintptr_t virtual_addr,
+				 void *xlat_table_base,
+				 unsigned int xlat_table_base_entries,
+				 unsigned long long virt_addr_space_size,
+				 unsigned int *out_level,
+				 bool invalid_page_ok)
 {
 	unsigned int start_level;
 	uint64_t *table;
@@ -300,7 +311,9 @@ static uint64_t *find_xlat_table_entry(uintptr_t virtual_addr,
 			 * Only page descriptors allowed at the final lookup
 			 * level.
 			 */
-			assert(desc_type == PAGE_DESC);
+			assert((desc_type == PAGE_DESC) ||
+			       (invalid_page_ok &&
+				(desc_type == (PAGE_DESC & ~XLAT_DESC_VALID))));
 			*out_level = level;
 			return &table[idx];
 		}
@@ -324,6 +337,17 @@ static uint64_t *find_xlat_table_entry(uintptr_t virtual_addr,
 	return NULL;
 }
 
+static uint64_t *find_xlat_table_entry(uintptr_t virtual_addr,
+				       void *xlat_table_base,
+				       unsigned int xlat_table_base_entries,
+				       unsigned long long virt_addr_space_size,
+				       unsigned int *out_level)
+{
+	return xlat_table_walk(virtual_addr, xlat_table_base,
+			       xlat_table_base_entries, virt_addr_space_size,
+			       out_level, false);
+}
+
 
 static int xlat_get_mem_attributes_internal(const xlat_ctx_t *ctx,
 		uintptr_t base_va, uint32_t *attributes, uint64_t **table_entry,
@@ -520,15 +544,23 @@ int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 	/* Restore original value. */
 	base_va = base_va_original;
 
-	for (unsigned int i = 0U; i < pages_count; ++i) {
-
+	/*
+	 * The break-before-make sequence requires writing an invalid
+	 * descriptor and making sure that the system sees the change before
+	 * writing the new descriptor. It is done for the whole range at once
+	 * so that a single TLB maintenance sequence covers all of its pages.
+	 * Each descriptor is first replaced by the new one with its valid bit
+	 * cleared: the hardware sees it as invalid, and it only needs to be
+	 * made valid again once the TLBs have been invalidated.
+	 */
+	for (size_t i = 0U; i < pages_count; ++i) {
 		uint32_t old_attr = 0U, new_attr;
 		uint64_t *entry = NULL;
 		unsigned int level = 0U;
 		unsigned long long addr_pa = 0ULL;
 
 		(void) xlat_get_mem_attributes_internal(ctx, base_va, &old_attr,
-					    &entry, &addr_pa, &level);
+						&entry, &addr_pa, &level);
 
 		/*
 		 * From attr, only MT_RO/MT_RW, MT_EXECUTE/MT_EXECUTE_NEVER and
@@ -545,26 +577,50 @@ int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 		 */
 		new_attr |= attr & (MT_RW | MT_EXECUTE_NEVER | MT_USER);
 
-		/*
-		 * The break-before-make sequence requires writing an invalid
-		 * descriptor and making sure that the system sees the change
-		 * before writing the new descriptor.
-		 */
-		*entry = INVALID_DESC;
+		*entry = xlat_desc(ctx, new_attr, addr_pa, level) &
+			 ~XLAT_DESC_VALID;
 #if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
 		dccvac((uintptr_t)entry);
 #endif
-		/* Invalidate any cached copy of this mapping in the TLBs. */
-		xlat_arch_tlbi_va(base_va, ctx->xlat_regime);
 
-		/* Ensure completion of the invalidation. */
-		xlat_arch_tlbi_va_sync();
+		base_va += PAGE_SIZE;
+	}
+
+	/* Invalidate any cached copy of these mappings in the TLBs. */
+	xlat_arch_tlbi_va_range(base_va_original, size, ctx->xlat_regime);
+
+	/* Ensure completion of the invalidation. */
+	xlat_arch_tlbi_va_sync();
+
+	/*
+	 * Make the new descriptors valid. The descriptors of consecutive pages
+	 * are adjacent within a level 3 table, so the tables are only walked
+	 * again for the first page of each of them.
+	 */
+	uint64_t *entry = NULL;
 
-		/* Write new descriptor */
-		*entry = xlat_desc(ctx, new_attr, addr_pa, level);
+	base_va = base_va_original;
+
+	for (size_t i = 0U; i < pages_count; ++i) {
+		unsigned int level;
+
+		if ((entry == NULL) ||
+		    ((base_va & XLAT_BLOCK_MASK(XLAT_TABLE_LEVEL_MAX - 1U)) ==
+		     0U)) {
+			entry = xlat_table_walk(base_va, ctx->base_table,
+						ctx->base_table_entries,
+						virt_addr_space_size, &level,
+						true);
+			assert(entry != NULL);
+		} else {
+			entry++;
+		}
+
+		*entry |= XLAT_DESC_VALID;
 #if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
 		dccvac((uintptr_t)entry);
 #endif
+
 		base_va += PAGE_SIZE;
 	}
 
@@ -43,6 +43,10 @@ BRANCH_PROTECTION		:= 0
 # The platform Makefile is free to override this value.
 COLD_BOOT_SINGLE_CPU		:= 0
 
+# Buffer the console output of the EL3 runtime firmware, so that logging doesn't
+# wait for the consoles to transmit it.
+CONSOLE_BUFFERED		:= 0
+
 # Flag to compile in coreboot support code. Exclude by default. The coreboot
 # Makefile system will set this when compiling TF as part of a coreboot image.
 COREBOOT			:= 0
@@ -50,6 +54,9 @@ COREBOOT			:= 0
 # For Chain of Trust
 CREATE_KEYS			:= 1
 
+# Only switch the optional EL1 system register groups declared by the SPD
+CTX_EL1_SYSREGS_GROUPS		:= 0
+
 # Build flag to include AArch32 registers in cpu context save and restore during
 # world switch. This flag must be set to 0 for AArch64-only platforms.
 CTX_INCLUDE_AARCH32_REGS	:= 1
@@ -57,6 +64,10 @@ CTX_INCLUDE_AARCH32_REGS	:= 1
 # Include FP registers in cpu context
 CTX_INCLUDE_FPREGS		:= 0
 
+# Switch the FP registers lazily, on the first trapped Secure world access,
+# rather than on every world switch. Requires CTX_INCLUDE_FPREGS.
+CTX_LAZY_FPREGS			:= 0
+
 # Include pointer authentication (ARMv8.3-PAuth) registers in cpu context. This
 # must be set to 1 if the platform wants to use this feature in the Secure
 # world. It is not needed to use it in the Non-secure world.
@@ -96,6 +107,12 @@ ENABLE_STACK_PROTECTOR		:= 0
 # Flag to enable exception handling in EL3
 EL3_EXCEPTION_HANDLING		:= 0
 
+# Flag to record the events handled by BL31 in a per-CPU trace
+EL3_TRACE			:= 0
+
+# Flag to let the Normal world read the EL3 trace. For development only.
+EL3_TRACE_NS_READ		:= 0
+
 # Flag to enable Branch Target Identification.
 # Internal flag not meant for direct setting.
 # Use BRANCH_PROTECTION to enable BTI.
@@ -124,6 +141,15 @@ FWU_FIP_NAME			:= fwu_fip.bin
 # For Chain of Trust
 GENERATE_COT			:= 0
 
+# Support for the GICv3.1 extended SPI and PPI ranges in the GICv3 driver, and
+# the number of extended SPIs the driver reserves save/restore space for.
+GIC_EXT_INTID			:= 0
+GIC_EXT_SPI_NUM			:= 1024
+
+# Have the primary CPU wake up the GICv3 Redistributors of all CPUs in parallel
+# at cold boot, rather than each CPU waking up its own.
+GICV3_PARALLEL_RDIST_WAKE	:= 0
+
 # Hint platform interrupt control layer that Group 0 interrupts are for EL3. By
 # default, they are for Secure EL1.
 GICV2_G0_FOR_EL3		:= 0
@@ -139,6 +165,14 @@ HW_ASSISTED_COHERENCY		:= 0
 # Set the default algorithm for the generation of Trusted Board Boot keys
 KEY_ALG				:= rsa
 
+# Flag set by the options that record latency histograms, to build the
+# histogram library into BL31. Internal flag not meant for direct setting.
+LATENCY_HIST_NEEDED		:= 0
+
+# Output log messages as a token and their raw arguments, to be formatted by the
+# log_detokenize host tool, instead of formatting them at runtime.
+LOG_TOKENIZED			:= 0
+
 # NS timer register save and restore
 NS_TIMER_SWITCH			:= 0
 
@@ -167,6 +201,9 @@ SAVE_KEYS			:= 0
 # Software Delegated Exception support
 SDEI_SUPPORT            	:= 0
 
+# Flag to gather SDEI dispatch latency statistics
+SDEI_LATENCY_STATS		:= 0
+
 # Whether code and read-only data should be put on separate memory pages. The
 # platform Makefile is free to override this value.
 SEPARATE_CODE_AND_RODATA	:= 0
@@ -184,6 +221,14 @@ ENABLE_SPM			:= 0
 # Use the SPM based on MM
 SPM_MM				:= 1
 
+# Give each CPU its own context in the SPM based on MM, so that CPUs can execute
+# in the Secure Partition concurrently
+SPM_MM_MP			:= 0
+
+# Initialize the Secure Partitions of the SPM on the secondary CPUs as they are
+# turned on, instead of one after the other on the boot CPU
+SPM_PARALLEL_INIT		:= 0
+
 # Flag to introduce an infinite loop in BL1 just before it exits into the next
 # image. This is meant to help debugging the post-BL2 phase.
 SPIN_ON_BL1_EXIT		:= 0
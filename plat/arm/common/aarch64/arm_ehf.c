@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -27,6 +27,10 @@ ehf_pri_desc_t arm_exceptions[] = {
 #if ENABLE_SPM
 	EHF_PRI_DESC(ARM_PRI_BITS, PLAT_SP_PRI),
 #endif
+#if TSPD_YIELD_QUEUE
+	/* TSPD queuing of yielding SMCs */
+	EHF_PRI_DESC(ARM_PRI_BITS, PLAT_TSPD_QUEUE_PRI),
+#endif
 };
 
 /* Plug in ARM exceptions to Exception Handling Framework. */
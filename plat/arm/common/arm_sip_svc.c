@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -8,9 +8,13 @@
 
 #include <common/debug.h>
 #include <common/runtime_svc.h>
+#include <lib/el3_trace.h>
 #include <lib/pmf/pmf.h>
 #include <plat/arm/common/arm_sip_svc.h>
 #include <plat/arm/common/plat_arm.h>
+#include <services/opteed_svc.h>
+#include <services/sdei.h>
+#include <services/trusty_svc.h>
 #include <tools_share/uuid.h>
 
 /* ARM SiP Service UUID */
@@ -69,6 +73,26 @@ static uintptr_t arm_sip_handler(unsigned int smc_fid,
 				(uint32_t) x4, handle);
 		}
 
+#if SDEI_LATENCY_STATS
+	case ARM_SIP_SVC_SDEI_LATENCY_STATS:
+		return sdei_latency_stats_smc(handle, x1, x2, x3);
+#endif
+
+#if EL3_TRACE
+	case ARM_SIP_SVC_EL3_TRACE_READ:
+		return el3_trace_read_smc(handle, flags, x1, x2);
+#endif
+
+#if OPTEED_SWITCH_STATS
+	case ARM_SIP_SVC_OPTEED_SWITCH_STATS:
+		return opteed_switch_stats_smc(handle, x1);
+#endif
+
+#if TRUSTY_FIQ_LATENCY_STATS
+	case ARM_SIP_SVC_TRUSTY_FIQ_LATENCY:
+		return trusty_fiq_latency_stats_smc(handle, x1, x2);
+#endif
+
 	case ARM_SIP_SVC_CALL_COUNT:
 		/* PMF calls */
 		call_count += PMF_NUM_SMC_CALLS;
@@ -76,6 +100,26 @@ static uintptr_t arm_sip_handler(unsigned int smc_fid,
 		/* State switch call */
 		call_count += 1;
 
+#if SDEI_LATENCY_STATS
+		/* SDEI latency statistics call */
+		call_count += 1;
+#endif
+
+#if EL3_TRACE
+		/* EL3 trace read call */
+		call_count += 1;
+#endif
+
+#if OPTEED_SWITCH_STATS
+		/* OPTEED world switch counters call */
+		call_count += 1;
+#endif
+
+#if TRUSTY_FIQ_LATENCY_STATS
+		/* Trusty FIQ latency statistics call */
+		call_count += 1;
+#endif
+
 		SMC_RET1(handle, call_count);
 
 	case ARM_SIP_SVC_UID:
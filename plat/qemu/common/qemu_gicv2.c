@@ -20,10 +20,15 @@ static const struct gicv2_driver_data plat_gicv2_driver_data = {
 	.interrupt_props_num = ARRAY_SIZE(qemu_interrupt_props),
 };
 
+void plat_qemu_gic_driver_init(void)
+{
+	gicv2_driver_init(&plat_gicv2_driver_data);
+}
+
 void plat_qemu_gic_init(void)
 {
 	/* Initialize the gic cpu and distributor interfaces */
-	gicv2_driver_init(&plat_gicv2_driver_data);
+	plat_qemu_gic_driver_init();
 	gicv2_distif_init();
 	gicv2_pcpu_distif_init();
 	gicv2_cpuif_enable();
@@ -31,9 +31,14 @@ static const gicv3_driver_data_t qemu_gicv3_driver_data = {
 	.mpidr_to_core_pos = qemu_mpidr_to_core_pos
 };
 
-void plat_qemu_gic_init(void)
+void plat_qemu_gic_driver_init(void)
 {
 	gicv3_driver_init(&qemu_gicv3_driver_data);
+}
+
+void plat_qemu_gic_init(void)
+{
+	plat_qemu_gic_driver_init();
 	gicv3_distif_init();
 	gicv3_rdistif_init(plat_my_core_pos());
 	gicv3_cpuif_enable(plat_my_core_pos());
@@ -31,6 +31,7 @@ unsigned int plat_qemu_calc_core_pos(u_register_t mpidr);
 void qemu_console_init(void);
 
 void plat_qemu_gic_init(void);
+void plat_qemu_gic_driver_init(void);
 void qemu_pwr_gic_on_finish(void);
 
 #endif /* QEMU_PRIVATE_H */
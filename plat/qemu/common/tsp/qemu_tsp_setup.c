@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <platform_def.h>
+
+#include <bl32/tsp/platform_tsp.h>
+#include <common/bl_common.h>
+
+#include "../qemu_private.h"
+
+/*******************************************************************************
+ * Initialize the UART. The TSP shares the boot console with BL31.
+ ******************************************************************************/
+void tsp_early_platform_setup(void)
+{
+	qemu_console_init();
+}
+
+/*******************************************************************************
+ * The GIC has been initialised by BL31, the TSP only needs the driver data to
+ * acknowledge and complete its interrupts.
+ ******************************************************************************/
+void tsp_platform_setup(void)
+{
+	plat_qemu_gic_driver_init();
+}
+
+/*******************************************************************************
+ * Perform the very early platform specific architectural setup here. At the
+ * moment this is only intializes the MMU
+ ******************************************************************************/
+void tsp_plat_arch_setup(void)
+{
+	qemu_configure_mmu_el1(BL32_BASE, (BL32_END - BL32_BASE),
+			      BL_CODE_BASE, BL_CODE_END,
+			      BL_RO_DATA_BASE, BL_RO_DATA_END,
+			      BL_COHERENT_RAM_BASE, BL_COHERENT_RAM_END);
+}
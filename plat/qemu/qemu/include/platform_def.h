@@ -165,6 +165,12 @@
 # error "Unsupported BL32_RAM_LOCATION_ID value"
 #endif
 
+/*
+ * The Test Secure Payload occupies the whole of the BL3-2 memory.
+ */
+#define TSP_SEC_MEM_BASE		BL32_MEM_BASE
+#define TSP_SEC_MEM_SIZE		BL32_MEM_SIZE
+
 #define NS_IMAGE_OFFSET			(NS_DRAM0_BASE + 0x20000000)
 #define NS_IMAGE_MAX_SIZE		(NS_DRAM0_SIZE - 0x20000000)
 
@@ -222,6 +228,9 @@
 #define QEMU_IRQ_SEC_SGI_6		14
 #define QEMU_IRQ_SEC_SGI_7		15
 
+#define QEMU_IRQ_SEC_PHY_TIMER		29
+#define TSP_IRQ_SEC_PHY_TIMER		QEMU_IRQ_SEC_PHY_TIMER
+
 /******************************************************************************
  * On a GICv2 system, the Group 1 secure interrupts are treated as Group 0
  * interrupts.
@@ -242,7 +251,17 @@
 	INTR_PROP_DESC(QEMU_IRQ_SEC_SGI_6, GIC_HIGHEST_SEC_PRIORITY,	\
 					   grp, GIC_INTR_CFG_EDGE),	\
 	INTR_PROP_DESC(QEMU_IRQ_SEC_SGI_7, GIC_HIGHEST_SEC_PRIORITY,	\
-					   grp, GIC_INTR_CFG_EDGE)
+					   grp, GIC_INTR_CFG_EDGE)	\
+	QEMU_TSP_G1S_PROPS(grp)
+
+/* The secure physical timer is only used by the Test Secure Payload */
+#ifdef SPD_tspd
+#define QEMU_TSP_G1S_PROPS(grp)						\
+	, INTR_PROP_DESC(QEMU_IRQ_SEC_PHY_TIMER, GIC_HIGHEST_SEC_PRIORITY, \
+					   grp, GIC_INTR_CFG_LEVEL)
+#else
+#define QEMU_TSP_G1S_PROPS(grp)
+#endif
 
 #define PLATFORM_G0_PROPS(grp)
 
@@ -0,0 +1,12 @@
+#
+# Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+# TSP source files specific to QEMU platform
+BL32_SOURCES		+=	plat/common/aarch64/platform_mp_stack.S		\
+				plat/qemu/common/aarch64/plat_helpers.S		\
+				plat/qemu/common/topology.c			\
+				plat/qemu/common/tsp/qemu_tsp_setup.c		\
+				${QEMU_GIC_SOURCES}
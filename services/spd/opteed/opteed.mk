@@ -16,3 +16,21 @@ NEED_BL32		:=	yes
 
 # required so that optee code can control access to the timer registers
 NS_TIMER_SWITCH		:=	1
+
+# Flag used to skip saving the secure system registers when OP-TEE returns from
+# a fast SMC, which OP-TEE handles without changing them.
+OPTEED_FAST_PATH		:=	0
+
+# Flag used to enable the counting of the entries into OP-TEE by the
+# dispatcher, which the normal world reads through a platform SMC.
+OPTEED_SWITCH_STATS		:=	0
+
+ifeq ($(OPTEED_SWITCH_STATS),1)
+SPD_SOURCES		+=	services/spd/opteed/opteed_stats.c
+endif
+
+$(eval $(call assert_boolean,OPTEED_FAST_PATH))
+$(eval $(call add_define,OPTEED_FAST_PATH))
+
+$(eval $(call assert_boolean,OPTEED_SWITCH_STATS))
+$(eval $(call add_define,OPTEED_SWITCH_STATS))
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -25,6 +25,7 @@
 #include <common/runtime_svc.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <plat/common/platform.h>
+#include <services/opteed_svc.h>
 #include <tools_share/uuid.h>
 
 #include "opteed_private.h"
@@ -72,6 +73,8 @@ static uint64_t opteed_sel1_interrupt_handler(uint32_t id,
 	optee_ctx = &opteed_sp_context[linear_id];
 	assert(&optee_ctx->cpu_ctx == cm_get_context(SECURE));
 
+	opteed_switch_count(OPTEED_SWITCH_FIQ);
+
 	cm_set_elr_el3(SECURE, (uint64_t)&optee_vector_table->fiq_entry);
 	cm_el1_sysregs_context_restore(SECURE);
 	cm_set_next_eret_context(SECURE);
@@ -135,6 +138,13 @@ static int32_t opteed_setup(void)
 				dt_addr,
 				&opteed_sp_context[linear_id]);
 
+	/*
+	 * OP-TEE runs Trusted Applications at S-EL0 and uses the AArch32
+	 * system registers only when it is itself an AArch32 image.
+	 */
+	cm_el1_sysregs_set_groups(CTX_SYSREGS_GRP_EL0 | CTX_SYSREGS_GRP_FAULT |
+		((opteed_rw == OPTEE_AARCH32) ? CTX_SYSREGS_GRP_AARCH32 : 0U));
+
 	/*
 	 * All OPTEED initialization done. Now register our init function with
 	 * BL31 for deferred invocation
@@ -238,9 +248,15 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 		if (GET_SMC_TYPE(smc_fid) == SMC_TYPE_FAST) {
 			cm_set_elr_el3(SECURE, (uint64_t)
 					&optee_vector_table->fast_smc_entry);
+			optee_ctx->state |= OPTEE_STATE_FAST_CALL;
+			opteed_switch_count(OPTEED_SWITCH_FAST_CALL);
 		} else {
 			cm_set_elr_el3(SECURE, (uint64_t)
 					&optee_vector_table->yield_smc_entry);
+			opteed_switch_count((smc_fid ==
+					OPTEE_SMC_RETURN_FROM_RPC) ?
+					OPTEED_SWITCH_RPC_RETURN :
+					OPTEED_SWITCH_YIELD_CALL);
 		}
 
 		cm_el1_sysregs_context_restore(SECURE);
@@ -361,7 +377,17 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 		 * and return to the non-secure state.
 		 */
 		assert(handle == cm_get_context(SECURE));
-		cm_el1_sysregs_context_save(SECURE);
+
+		/*
+		 * OPTEE handles fast SMCs without changing its system
+		 * registers, so with OPTEED_FAST_PATH=1 the saved copy is
+		 * still up to date and only the non-secure context needs to
+		 * be restored, as for a S-EL1 FIQ.
+		 */
+		if (!OPTEED_FAST_PATH ||
+		    ((optee_ctx->state & OPTEE_STATE_FAST_CALL) == 0U))
+			cm_el1_sysregs_context_save(SECURE);
+		optee_ctx->state &= ~OPTEE_STATE_FAST_CALL;
 
 		/* Get a reference to the non-secure context */
 		ns_cpu_context = cm_get_context(NON_SECURE);
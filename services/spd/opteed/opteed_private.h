@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -33,6 +33,11 @@
 						OPTEE_PSTATE_SHIFT;	       \
 				} while (0)
 
+/*
+ * Set while OPTEE handles a fast SMC from the normal world, whose return does
+ * not need the secure system registers to be saved with OPTEED_FAST_PATH=1.
+ */
+#define OPTEE_STATE_FAST_CALL		(U(1) << 2)
 
 /*******************************************************************************
  * OPTEE execution state information i.e. aarch32 or aarch64
@@ -154,6 +159,15 @@ void opteed_init_optee_ep_state(struct entry_point_info *optee_entry_point,
 				uint64_t dt_addr,
 				optee_context_t *optee_ctx);
 
+/* World switch accounting, see opteed_stats.c */
+#if OPTEED_SWITCH_STATS
+void opteed_switch_count(unsigned int type);
+#else
+static inline void opteed_switch_count(unsigned int type)
+{
+}
+#endif
+
 extern optee_context_t opteed_sp_context[OPTEED_CORE_COUNT];
 extern uint32_t opteed_rw;
 extern struct optee_vectors *optee_vector_table;
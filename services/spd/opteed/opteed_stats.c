@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*******************************************************************************
+ * World switch accounting for the OPTEED. Each entry into OP-TEE is counted
+ * by cause in per-cpu counters, which the normal world reads through a
+ * platform SMC calling opteed_switch_stats_smc(). The number of switches per
+ * Trusted Application invocation follows from the number of yielding calls
+ * and of returns from RPC.
+ ******************************************************************************/
+#include <assert.h>
+
+#include <common/runtime_svc.h>
+#include <plat/common/platform.h>
+#include <services/opteed_svc.h>
+
+#include "opteed_private.h"
+
+typedef struct opteed_switch_stats {
+	uint64_t count[OPTEED_SWITCH_NUM_TYPES];
+} __aligned(CACHE_WRITEBACK_GRANULE) opteed_switch_stats_t;
+
+static opteed_switch_stats_t opteed_switch_stats[OPTEED_CORE_COUNT];
+
+void opteed_switch_count(unsigned int type)
+{
+	assert(type < OPTEED_SWITCH_NUM_TYPES);
+
+	opteed_switch_stats[plat_my_core_pos()].count[type]++;
+}
+
+/*******************************************************************************
+ * Report the counters of all cpus added together in x1-x4, in the order of the
+ * OPTEED_SWITCH_* types. Resetting them is only safe while no other cpu is
+ * issuing requests to OP-TEE.
+ ******************************************************************************/
+uintptr_t opteed_switch_stats_smc(void *handle, u_register_t flags)
+{
+	uint64_t total[OPTEED_SWITCH_NUM_TYPES] = { 0U };
+	unsigned int i, type;
+
+	for (i = 0U; i < OPTEED_CORE_COUNT; i++) {
+		for (type = 0U; type < OPTEED_SWITCH_NUM_TYPES; type++) {
+			total[type] += opteed_switch_stats[i].count[type];
+
+			if ((flags & OPTEED_SWITCH_FLAG_RESET) != 0U)
+				opteed_switch_stats[i].count[type] = 0U;
+		}
+	}
+
+	SMC_RET5(handle, SMC_OK, total[OPTEED_SWITCH_YIELD_CALL],
+		 total[OPTEED_SWITCH_RPC_RETURN],
+		 total[OPTEED_SWITCH_FAST_CALL], total[OPTEED_SWITCH_FIQ]);
+}
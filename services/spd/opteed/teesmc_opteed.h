@@ -120,4 +120,11 @@
 #define TEESMC_OPTEED_RETURN_SYSTEM_RESET_DONE \
 	TEESMC_OPTEED_RV(TEESMC_OPTEED_FUNCID_RETURN_SYSTEM_RESET_DONE)
 
+/*
+ * Yielding call from the normal world resuming the OP-TEE thread which
+ * returned with an RPC request, as defined by OP-TEE in optee_smc.h. The
+ * OPTEED only uses it to tell such calls apart from new requests.
+ */
+#define OPTEE_SMC_RETURN_FROM_RPC		0x32000003
+
 #endif /*TEESMC_OPTEED_H*/
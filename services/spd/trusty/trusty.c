@@ -16,7 +16,9 @@
 #include <common/debug.h>
 #include <common/runtime_svc.h>
 #include <lib/el3_runtime/context_mgmt.h>
+#include <lib/latency_hist.h>
 #include <plat/common/platform.h>
+#include <services/trusty_svc.h>
 
 #include "sm_err.h"
 #include "smcall.h"
@@ -32,6 +34,15 @@ struct trusty_stack {
 	uint32_t end;
 };
 
+#if TRUSTY_FIQ_FAST_PATH
+/*
+ * Number of general purpose registers of the interrupted normal world context
+ * saved on FIQ entry, from x0. The FIQ glue at EL1 restores all the others
+ * itself before SMC_FC_FIQ_EXIT, see trusty_fiq_exit().
+ */
+#define TRUSTY_FIQ_SAVED_GPREGS	18U
+#endif
+
 struct trusty_cpu_ctx {
 	cpu_context_t	cpu_ctx;
 	void		*saved_sp;
@@ -43,7 +54,17 @@ struct trusty_cpu_ctx {
 	uint64_t	fiq_pc;
 	uint64_t	fiq_cpsr;
 	uint64_t	fiq_sp_el1;
+#if TRUSTY_FIQ_FAST_PATH
+	uint64_t	fiq_gpregs[TRUSTY_FIQ_SAVED_GPREGS];
+	uint64_t	fiq_sp_el0;
+	/* A FIQ entry or exit round trip to Trusty is in progress */
+	int32_t		fiq_switch_active;
+#else
 	gp_regs_t	fiq_gpregs;
+#endif
+#if TRUSTY_FIQ_LATENCY_STATS
+	latency_hist_t	fiq_latency[TRUSTY_FIQ_LATENCY_NUM_CLASSES];
+#endif
 	struct trusty_stack	secure_stack;
 };
 
@@ -77,6 +98,27 @@ static bool is_hypervisor_mode(void)
 	return ((hcr & HYP_ENABLE_FLAG) != 0U) ? true : false;
 }
 
+/*
+ * To avoid the additional overhead in PSCI flow, skip FP context
+ * saving/restoring in case of CPU suspend and resume, assuming that
+ * when it's needed the PSCI caller has preserved FP context before
+ * going here.
+ *
+ * With TRUSTY_FIQ_FAST_PATH, it is also skipped in both worlds during the
+ * SMC_FC_FIQ_ENTER and SMC_FC_FIQ_EXIT round trips to Trusty, which handles
+ * them without using the FP/SIMD registers.
+ */
+static bool trusty_switch_fpregs(const struct trusty_cpu_ctx *ctx, uint64_t r0)
+{
+#if TRUSTY_FIQ_FAST_PATH
+	if (ctx->fiq_switch_active != 0) {
+		return false;
+	}
+#endif
+
+	return (r0 != SMC_FC_CPU_SUSPEND) && (r0 != SMC_FC_CPU_RESUME);
+}
+
 static struct smc_args trusty_context_switch(uint32_t security_state, uint64_t r0,
 					 uint64_t r1, uint64_t r2, uint64_t r3)
 {
@@ -102,14 +144,10 @@ static struct smc_args trusty_context_switch(uint32_t security_state, uint64_t r
 	args.r1 = r1;
 	args.r0 = r0;
 
-	/*
-	 * To avoid the additional overhead in PSCI flow, skip FP context
-	 * saving/restoring in case of CPU suspend and resume, assuming that
-	 * when it's needed the PSCI caller has preserved FP context before
-	 * going here.
-	 */
-	if (r0 != SMC_FC_CPU_SUSPEND && r0 != SMC_FC_CPU_RESUME)
+#if !CTX_LAZY_FPREGS
+	if (trusty_switch_fpregs(ctx, r0))
 		fpregs_context_save(get_fpregs_ctx(cm_get_context(security_state)));
+#endif
 	cm_el1_sysregs_context_save(security_state);
 
 	ctx->saved_security_state = security_state;
@@ -118,14 +156,111 @@ static struct smc_args trusty_context_switch(uint32_t security_state, uint64_t r
 	assert(ctx->saved_security_state == ((security_state == 0U) ? 1U : 0U));
 
 	cm_el1_sysregs_context_restore(security_state);
-	if (r0 != SMC_FC_CPU_SUSPEND && r0 != SMC_FC_CPU_RESUME)
+#if !CTX_LAZY_FPREGS
+	if (trusty_switch_fpregs(ctx, r0))
 		fpregs_context_restore(get_fpregs_ctx(cm_get_context(security_state)));
+#endif
 
 	cm_set_next_eret_context(security_state);
 
 	return ret_args;
 }
 
+/*
+ * Switch to Trusty to notify it of the entry into or the exit from the FIQ
+ * handler of the normal world.
+ */
+static struct smc_args trusty_fiq_context_switch(struct trusty_cpu_ctx *ctx,
+						 uint64_t r0)
+{
+	struct smc_args ret;
+
+#if TRUSTY_FIQ_FAST_PATH
+	ctx->fiq_switch_active = 1;
+#endif
+	ret = trusty_context_switch(NON_SECURE, r0, 0, 0, 0);
+#if TRUSTY_FIQ_FAST_PATH
+	ctx->fiq_switch_active = 0;
+#endif
+
+	return ret;
+}
+
+/*
+ * Without TRUSTY_FIQ_FAST_PATH, all the general purpose registers of the
+ * interrupted context are saved. Otherwise, only the ones the FIQ glue at EL1
+ * doesn't restore itself are.
+ */
+static void trusty_fiq_save_gpregs(struct trusty_cpu_ctx *ctx, void *handle)
+{
+#if TRUSTY_FIQ_FAST_PATH
+	(void)memcpy(ctx->fiq_gpregs, get_gpregs_ctx(handle), sizeof(ctx->fiq_gpregs));
+	ctx->fiq_sp_el0 = read_ctx_reg(get_gpregs_ctx(handle), CTX_GPREG_SP_EL0);
+#else
+	(void)memcpy(&ctx->fiq_gpregs, get_gpregs_ctx(handle), sizeof(ctx->fiq_gpregs));
+#endif
+}
+
+static void trusty_fiq_restore_gpregs(const struct trusty_cpu_ctx *ctx,
+				      void *handle)
+{
+#if TRUSTY_FIQ_FAST_PATH
+	(void)memcpy(get_gpregs_ctx(handle), ctx->fiq_gpregs, sizeof(ctx->fiq_gpregs));
+	write_ctx_reg(get_gpregs_ctx(handle), CTX_GPREG_SP_EL0, ctx->fiq_sp_el0);
+#else
+	(void)memcpy(get_gpregs_ctx(handle), &ctx->fiq_gpregs, sizeof(ctx->fiq_gpregs));
+#endif
+}
+
+static uint64_t trusty_fiq_sp_el0(const struct trusty_cpu_ctx *ctx)
+{
+#if TRUSTY_FIQ_FAST_PATH
+	return ctx->fiq_sp_el0;
+#else
+	return read_ctx_reg(&ctx->fiq_gpregs, CTX_GPREG_SP_EL0);
+#endif
+}
+
+#if TRUSTY_FIQ_LATENCY_STATS
+static void trusty_fiq_latency_record(struct trusty_cpu_ctx *ctx,
+				      unsigned int type, uint64_t start)
+{
+	latency_hist_record(&ctx->fiq_latency[type], read_cntpct_el0() - start);
+}
+
+/*
+ * Report the statistics of one class of intervals, merged across all cpus. x1
+ * holds the number of samples, and x2-x5 the minimum, median, 99th percentile
+ * and maximum latencies in system counter ticks. Resetting the statistics is
+ * only safe while no FIQ is being delivered to Trusty.
+ */
+uintptr_t trusty_fiq_latency_stats_smc(void *handle, u_register_t type,
+				       u_register_t flags)
+{
+	latency_hist_t hist;
+	unsigned int i;
+
+	if (type >= TRUSTY_FIQ_LATENCY_NUM_CLASSES) {
+		SMC_RET1(handle, SMC_UNK);
+	}
+
+	latency_hist_reset(&hist);
+	for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		latency_hist_merge(&hist, &trusty_cpu_ctx[i].fiq_latency[type]);
+
+		if ((flags & TRUSTY_FIQ_LATENCY_FLAG_RESET) != 0U) {
+			latency_hist_reset(&trusty_cpu_ctx[i].fiq_latency[type]);
+		}
+	}
+
+	SMC_RET6(handle, SMC_OK, hist.count,
+		 latency_hist_percentile(&hist, 0U),
+		 latency_hist_percentile(&hist, 50U),
+		 latency_hist_percentile(&hist, 99U),
+		 latency_hist_percentile(&hist, 100U));
+}
+#endif /* TRUSTY_FIQ_LATENCY_STATS */
+
 static uint64_t trusty_fiq_handler(uint32_t id,
 				   uint32_t flags,
 				   void *handle,
@@ -133,10 +268,13 @@ static uint64_t trusty_fiq_handler(uint32_t id,
 {
 	struct smc_args ret;
 	struct trusty_cpu_ctx *ctx = get_trusty_ctx();
+#if TRUSTY_FIQ_LATENCY_STATS
+	uint64_t start = read_cntpct_el0();
+#endif
 
 	assert(!is_caller_secure(flags));
 
-	ret = trusty_context_switch(NON_SECURE, SMC_FC_FIQ_ENTER, 0, 0, 0);
+	ret = trusty_fiq_context_switch(ctx, SMC_FC_FIQ_ENTER);
 	if (ret.r0 != 0U) {
 		SMC_RET0(handle);
 	}
@@ -147,7 +285,7 @@ static uint64_t trusty_fiq_handler(uint32_t id,
 	}
 
 	ctx->fiq_handler_active = 1;
-	(void)memcpy(&ctx->fiq_gpregs, get_gpregs_ctx(handle), sizeof(ctx->fiq_gpregs));
+	trusty_fiq_save_gpregs(ctx, handle);
 	ctx->fiq_pc = SMC_GET_EL3(handle, CTX_ELR_EL3);
 	ctx->fiq_cpsr = SMC_GET_EL3(handle, CTX_SPSR_EL3);
 	ctx->fiq_sp_el1 = read_ctx_reg(get_sysregs_ctx(handle), CTX_SP_EL1);
@@ -155,6 +293,10 @@ static uint64_t trusty_fiq_handler(uint32_t id,
 	write_ctx_reg(get_sysregs_ctx(handle), CTX_SP_EL1, ctx->fiq_handler_sp);
 	cm_set_elr_spsr_el3(NON_SECURE, ctx->fiq_handler_pc, (uint32_t)ctx->fiq_handler_cpsr);
 
+#if TRUSTY_FIQ_LATENCY_STATS
+	trusty_fiq_latency_record(ctx, TRUSTY_FIQ_LATENCY_ENTRY, start);
+#endif
+
 	SMC_RET0(handle);
 }
 
@@ -179,7 +321,7 @@ static uint64_t trusty_set_fiq_handler(void *handle, uint64_t cpu,
 static uint64_t trusty_get_fiq_regs(void *handle)
 {
 	struct trusty_cpu_ctx *ctx = get_trusty_ctx();
-	uint64_t sp_el0 = read_ctx_reg(&ctx->fiq_gpregs, CTX_GPREG_SP_EL0);
+	uint64_t sp_el0 = trusty_fiq_sp_el0(ctx);
 
 	SMC_RET4(handle, ctx->fiq_pc, ctx->fiq_cpsr, sp_el0, ctx->fiq_sp_el1);
 }
@@ -188,13 +330,16 @@ static uint64_t trusty_fiq_exit(void *handle, uint64_t x1, uint64_t x2, uint64_t
 {
 	struct smc_args ret;
 	struct trusty_cpu_ctx *ctx = get_trusty_ctx();
+#if TRUSTY_FIQ_LATENCY_STATS
+	uint64_t start = read_cntpct_el0();
+#endif
 
 	if (ctx->fiq_handler_active == 0) {
 		NOTICE("%s: fiq handler not active\n", __func__);
 		SMC_RET1(handle, (uint64_t)SM_ERR_INVALID_PARAMETERS);
 	}
 
-	ret = trusty_context_switch(NON_SECURE, SMC_FC_FIQ_EXIT, 0, 0, 0);
+	ret = trusty_fiq_context_switch(ctx, SMC_FC_FIQ_EXIT);
 	if (ret.r0 != 1U) {
 		INFO("%s(%p) SMC_FC_FIQ_EXIT returned unexpected value, %lld\n",
 		       __func__, handle, ret.r0);
@@ -208,12 +353,19 @@ static uint64_t trusty_fiq_exit(void *handle, uint64_t x1, uint64_t x2, uint64_t
 	 *
 	 * x1-x4 and x8-x17 need to be restored here because smc_handler64
 	 * corrupts them (el1 code also restored them).
+	 *
+	 * The other registers are only restored when not built with
+	 * TRUSTY_FIQ_FAST_PATH.
 	 */
-	(void)memcpy(get_gpregs_ctx(handle), &ctx->fiq_gpregs, sizeof(ctx->fiq_gpregs));
+	trusty_fiq_restore_gpregs(ctx, handle);
 	ctx->fiq_handler_active = 0;
 	write_ctx_reg(get_sysregs_ctx(handle), CTX_SP_EL1, ctx->fiq_sp_el1);
 	cm_set_elr_spsr_el3(NON_SECURE, ctx->fiq_pc, (uint32_t)ctx->fiq_cpsr);
 
+#if TRUSTY_FIQ_LATENCY_STATS
+	trusty_fiq_latency_record(ctx, TRUSTY_FIQ_LATENCY_EXIT, start);
+#endif
+
 	SMC_RET0(handle);
 }
 
@@ -299,7 +451,9 @@ static int32_t trusty_init(void)
 	ep_info = bl31_plat_get_next_image_ep_info(SECURE);
 	assert(ep_info != NULL);
 
+#if !CTX_LAZY_FPREGS
 	fpregs_context_save(get_fpregs_ctx(cm_get_context(NON_SECURE)));
+#endif
 	cm_el1_sysregs_context_save(NON_SECURE);
 
 	cm_set_context(&ctx->cpu_ctx, SECURE);
@@ -316,7 +470,9 @@ static int32_t trusty_init(void)
 	}
 
 	cm_el1_sysregs_context_restore(SECURE);
+#if !CTX_LAZY_FPREGS
 	fpregs_context_restore(get_fpregs_ctx(cm_get_context(SECURE)));
+#endif
 	cm_set_next_eret_context(SECURE);
 
 	ctx->saved_security_state = ~0U; /* initial saved state is invalid */
@@ -325,7 +481,9 @@ static int32_t trusty_init(void)
 	(void)trusty_context_switch_helper(&ctx->saved_sp, &zero_args);
 
 	cm_el1_sysregs_context_restore(NON_SECURE);
+#if !CTX_LAZY_FPREGS
 	fpregs_context_restore(get_fpregs_ctx(cm_get_context(NON_SECURE)));
+#endif
 	cm_set_next_eret_context(NON_SECURE);
 
 	return 1;
@@ -449,6 +607,13 @@ static int32_t trusty_setup(void)
 	(void)memset(&ep_info->args, 0, sizeof(ep_info->args));
 	plat_trusty_set_boot_args(&ep_info->args);
 
+	/*
+	 * Trusty runs applications at S-EL0 and uses the AArch32 system
+	 * registers only when it is itself an AArch32 image.
+	 */
+	cm_el1_sysregs_set_groups(CTX_SYSREGS_GRP_EL0 | CTX_SYSREGS_GRP_FAULT |
+		(aarch32 ? CTX_SYSREGS_GRP_AARCH32 : 0U));
+
 	/* register init handler */
 	bl31_register_bl32_init(trusty_init);
 
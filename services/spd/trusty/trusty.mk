@@ -13,6 +13,26 @@ ifeq (${TRUSTY_SPD_WITH_GENERIC_SERVICES},1)
 SPD_SOURCES		+=	services/spd/trusty/generic-arm64-smcall.c
 endif
 
+# Flag used to shorten the delivery of the FIQs of the normal world to Trusty,
+# by only saving the registers the FIQ glue doesn't restore itself, and by not
+# switching the FP/SIMD registers while notifying Trusty of the FIQ entry and
+# exit.
+TRUSTY_FIQ_FAST_PATH		:=	0
+
+# Flag used to enable the gathering of FIQ entry and exit latency statistics by
+# the dispatcher, which the normal world reads through a platform SMC.
+TRUSTY_FIQ_LATENCY_STATS	:=	0
+
+ifeq ($(TRUSTY_FIQ_LATENCY_STATS),1)
+LATENCY_HIST_NEEDED	:=	1
+endif
+
+$(eval $(call assert_boolean,TRUSTY_FIQ_FAST_PATH))
+$(eval $(call add_define,TRUSTY_FIQ_FAST_PATH))
+
+$(eval $(call assert_boolean,TRUSTY_FIQ_LATENCY_STATS))
+$(eval $(call add_define,TRUSTY_FIQ_LATENCY_STATS))
+
 NEED_BL32		:=	yes
 
 CTX_INCLUDE_FPREGS	:=	1
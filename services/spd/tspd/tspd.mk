@@ -1,5 +1,5 @@
 #
-# Copyright (c) 2013-2018, ARM Limited and Contributors. All rights reserved.
+# Copyright (c) 2013-2019, ARM Limited and Contributors. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -42,5 +42,31 @@ $(error When EL3_EXCEPTION_HANDLING=1, TSP_NS_INTR_ASYNC_PREEMPT must also be 1)
 endif
 endif
 
+# Flag used to enable the gathering of world switch latency statistics by the
+# dispatcher, which the normal world reads with the TSP_FID_LATENCY_STATS SMC.
+TSPD_LATENCY_STATS		:=	0
+
+ifeq ($(TSPD_LATENCY_STATS),1)
+SPD_SOURCES		+=	services/spd/tspd/tspd_latency.c
+LATENCY_HIST_NEEDED	:=	1
+endif
+
+# Flag used to enable the queuing of yielding SMCs to idle cpus by the
+# dispatcher, with the TSP_FID_QUEUE and TSP_FID_QUEUE_RESULT SMCs.
+TSPD_YIELD_QUEUE		:=	0
+
+ifeq ($(TSPD_YIELD_QUEUE),1)
+ifeq ($(EL3_EXCEPTION_HANDLING),0)
+$(error TSPD_YIELD_QUEUE=1 requires EL3_EXCEPTION_HANDLING=1)
+endif
+SPD_SOURCES		+=	services/spd/tspd/tspd_queue.c
+endif
+
 $(eval $(call assert_boolean,TSP_NS_INTR_ASYNC_PREEMPT))
 $(eval $(call add_define,TSP_NS_INTR_ASYNC_PREEMPT))
+
+$(eval $(call assert_boolean,TSPD_LATENCY_STATS))
+$(eval $(call add_define,TSPD_LATENCY_STATS))
+
+$(eval $(call assert_boolean,TSPD_YIELD_QUEUE))
+$(eval $(call add_define,TSPD_YIELD_QUEUE))
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*******************************************************************************
+ * World switch latency accounting for the TSPD. Each request from the normal
+ * world is timed from its entry into the TSPD until the TSPD hands control
+ * back to the normal world, using the system counter. The samples are sorted
+ * into per-cpu histograms which the normal world reads with the
+ * TSP_FID_LATENCY_STATS SMC.
+ *
+ * For yielding SMCs only the time spent in EL3 and S-EL1 is accounted for: the
+ * time the normal world spends handling the interrupts which preempt the TSP
+ * before resuming it is excluded.
+ ******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+
+#include <arch_helpers.h>
+#include <bl32/tsp/tsp.h>
+#include <common/runtime_svc.h>
+#include <lib/latency_hist.h>
+#include <plat/common/platform.h>
+
+#include "tspd_private.h"
+
+typedef struct tspd_latency {
+	/* Counter value at the start of each class of request */
+	uint64_t start[TSP_LATENCY_NUM_CLASSES];
+
+	/* Ticks accumulated by the yielding SMC in progress */
+	uint64_t yield_ticks;
+
+	/* The yielding SMC in progress was preempted at least once */
+	bool yield_preempted;
+
+	latency_hist_t hist[TSP_LATENCY_NUM_CLASSES];
+} tspd_latency_t;
+
+static tspd_latency_t tspd_latency[TSPD_CORE_COUNT];
+
+void tspd_latency_start(unsigned int type)
+{
+	tspd_latency_t *lat = &tspd_latency[plat_my_core_pos()];
+
+	assert(type < TSP_LATENCY_NUM_CLASSES);
+
+	if (type == TSP_LATENCY_YIELD_SMC) {
+		lat->yield_ticks = 0U;
+		lat->yield_preempted = false;
+	}
+
+	lat->start[type] = read_cntpct_el0();
+}
+
+void tspd_latency_stop(unsigned int type)
+{
+	tspd_latency_t *lat = &tspd_latency[plat_my_core_pos()];
+	uint64_t ticks;
+
+	assert(type < TSP_LATENCY_NUM_CLASSES);
+
+	ticks = read_cntpct_el0() - lat->start[type];
+
+	if (type == TSP_LATENCY_YIELD_SMC) {
+		ticks += lat->yield_ticks;
+		if (lat->yield_preempted)
+			type = TSP_LATENCY_PREEMPTED_SMC;
+	}
+
+	latency_hist_record(&lat->hist[type], ticks);
+}
+
+void tspd_latency_yield_preempted(void)
+{
+	tspd_latency_t *lat = &tspd_latency[plat_my_core_pos()];
+
+	lat->yield_ticks += read_cntpct_el0() -
+			    lat->start[TSP_LATENCY_YIELD_SMC];
+	lat->yield_preempted = true;
+}
+
+void tspd_latency_yield_resumed(void)
+{
+	tspd_latency_t *lat = &tspd_latency[plat_my_core_pos()];
+
+	lat->start[TSP_LATENCY_YIELD_SMC] = read_cntpct_el0();
+}
+
+/*******************************************************************************
+ * Handler for TSP_FID_LATENCY_STATS. The histograms of all cpus are merged
+ * before being reported. Resetting them is only safe while no other cpu is
+ * issuing requests to the TSP.
+ ******************************************************************************/
+uintptr_t tspd_latency_stats_smc(void *handle, u_register_t type,
+				 u_register_t flags)
+{
+	latency_hist_t hist;
+	unsigned int i;
+
+	if (type >= TSP_LATENCY_NUM_CLASSES)
+		SMC_RET1(handle, SMC_UNK);
+
+	latency_hist_reset(&hist);
+	for (i = 0U; i < TSPD_CORE_COUNT; i++) {
+		latency_hist_merge(&hist, &tspd_latency[i].hist[type]);
+
+		if ((flags & TSP_LATENCY_FLAG_RESET) != 0U)
+			latency_hist_reset(&tspd_latency[i].hist[type]);
+	}
+
+	SMC_RET6(handle, SMC_OK, hist.count,
+		 latency_hist_percentile(&hist, 0U),
+		 latency_hist_percentile(&hist, 50U),
+		 latency_hist_percentile(&hist, 99U),
+		 latency_hist_percentile(&hist, 100U));
+}
@@ -80,6 +80,8 @@ uint64_t tspd_handle_sp_preemption(void *handle)
 	cm_el1_sysregs_context_restore(NON_SECURE);
 	cm_set_next_eret_context(NON_SECURE);
 
+	tspd_latency_yield_preempted();
+
 	/*
 	 * The TSP was preempted during execution of a Yielding SMC Call.
 	 * Return back to the normal world with SMC_PREEMPTED as error
@@ -107,6 +109,8 @@ static uint64_t tspd_sel1_interrupt_handler(uint32_t id,
 	/* Sanity check the pointer to this cpu's context */
 	assert(handle == cm_get_context(NON_SECURE));
 
+	tspd_latency_start(TSP_LATENCY_SEL1_INTR);
+
 	/* Save the non-secure context before entering the TSP */
 	cm_el1_sysregs_context_save(NON_SECURE);
 
@@ -219,6 +223,12 @@ static int32_t tspd_setup(void)
 				tsp_ep_info->pc,
 				&tspd_sp_context[linear_id]);
 
+	/*
+	 * The TSP runs at S-EL1 only, in AArch64 state, so it uses neither the
+	 * EL0 thread ID registers nor the AArch32 system registers.
+	 */
+	cm_el1_sysregs_set_groups(CTX_SYSREGS_GRP_FAULT);
+
 #if TSP_INIT_ASYNC
 	bl31_set_next_image_type(SECURE);
 #else
@@ -353,6 +363,8 @@ static uintptr_t tspd_smc_handler(uint32_t smc_fid,
 		cm_el1_sysregs_context_restore(NON_SECURE);
 		cm_set_next_eret_context(NON_SECURE);
 
+		tspd_latency_stop(TSP_LATENCY_SEL1_INTR);
+
 		SMC_RET0((uint64_t) ns_cpu_context);
 
 	/*
@@ -412,6 +424,14 @@ static uintptr_t tspd_smc_handler(uint32_t smc_fid,
 			 */
 			disable_intr_rm_local(INTR_TYPE_NS, SECURE);
 #endif
+
+#if TSPD_YIELD_QUEUE
+			/*
+			 * Register the handler of the SGI signalling the
+			 * yielding SMCs queued to this cpu by other cpus.
+			 */
+			tspd_queue_init();
+#endif
 		}
 
 
@@ -507,6 +527,10 @@ static uintptr_t tspd_smc_handler(uint32_t smc_fid,
 			if (get_yield_smc_active_flag(tsp_ctx->state))
 				SMC_RET1(handle, SMC_UNK);
 
+			tspd_latency_start(
+				(GET_SMC_TYPE(smc_fid) == SMC_TYPE_FAST) ?
+				TSP_LATENCY_FAST_SMC : TSP_LATENCY_YIELD_SMC);
+
 			cm_el1_sysregs_context_save(NON_SECURE);
 
 			/* Save x1 and x2 for use by TSP_GET_ARGS call below */
@@ -571,6 +595,17 @@ static uintptr_t tspd_smc_handler(uint32_t smc_fid,
 			 * and return to the non-secure state.
 			 */
 			assert(handle == cm_get_context(SECURE));
+
+#if TSPD_YIELD_QUEUE
+			/*
+			 * The result of a request queued by another cpu is
+			 * kept for that cpu. The normal world context of this
+			 * cpu is restored by the SGI handler.
+			 */
+			if (get_queued_smc_active_flag(tsp_ctx->state))
+				tspd_queue_smc_done(tsp_ctx, x1, x2, x3);
+#endif
+
 			cm_el1_sysregs_context_save(SECURE);
 
 			/* Get a reference to the non-secure context */
@@ -590,8 +625,18 @@ static uintptr_t tspd_smc_handler(uint32_t smc_fid,
 				 */
 				disable_intr_rm_local(INTR_TYPE_NS, SECURE);
 #endif
+				/*
+				 * The normal world context was restored while
+				 * the SMC was still marked active, check again
+				 * for a request posted meanwhile.
+				 */
+				tspd_queue_kick();
 			}
 
+			tspd_latency_stop(
+				(GET_SMC_TYPE(smc_fid) == SMC_TYPE_FAST) ?
+				TSP_LATENCY_FAST_SMC : TSP_LATENCY_YIELD_SMC);
+
 			SMC_RET3(ns_cpu_context, x1, x2, x3);
 		}
 		assert(0); /* Unreachable */
@@ -650,6 +695,8 @@ static uintptr_t tspd_smc_handler(uint32_t smc_fid,
 		if (!get_yield_smc_active_flag(tsp_ctx->state))
 			SMC_RET1(handle, SMC_UNK);
 
+		tspd_latency_yield_resumed();
+
 		cm_el1_sysregs_context_save(NON_SECURE);
 
 		/*
@@ -693,6 +740,36 @@ static uintptr_t tspd_smc_handler(uint32_t smc_fid,
 		get_tsp_args(tsp_ctx, x1, x2);
 		SMC_RET2(handle, x1, x2);
 
+#if TSPD_LATENCY_STATS
+		/*
+		 * Request from the non-secure world for the world switch
+		 * latency statistics. The TSP is not involved.
+		 */
+	case TSP_FID_LATENCY_STATS:
+		if (!ns)
+			SMC_RET1(handle, SMC_UNK);
+
+		return tspd_latency_stats_smc(handle, x1, x2);
+#endif
+
+#if TSPD_YIELD_QUEUE
+		/*
+		 * Requests from the non-secure world to queue a yielding SMC
+		 * to another cpu, and to read its result.
+		 */
+	case TSP_FID_QUEUE:
+		if (!ns)
+			SMC_RET1(handle, SMC_UNK);
+
+		return tspd_queue_smc(handle, x1, x2, x3);
+
+	case TSP_FID_QUEUE_RESULT:
+		if (!ns)
+			SMC_RET1(handle, SMC_UNK);
+
+		return tspd_queue_result_smc(handle, x1);
+#endif
+
 	case TOS_CALL_COUNT:
 		/*
 		 * Return the number of service function IDs implemented to
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -53,6 +53,22 @@
 					~(YIELD_SMC_ACTIVE_FLAG_MASK	\
 					<< YIELD_SMC_ACTIVE_FLAG_SHIFT))
 
+/*
+ * This flag is set while the TSP runs a yielding SMC queued by another cpu
+ * with TSP_FID_QUEUE, so that its result is kept for that cpu instead of being
+ * returned to the normal world of this one.
+ */
+#define QUEUED_SMC_ACTIVE_FLAG_SHIFT	3
+#define QUEUED_SMC_ACTIVE_FLAG_MASK	1
+#define get_queued_smc_active_flag(state)				\
+				((state >> QUEUED_SMC_ACTIVE_FLAG_SHIFT) \
+				& QUEUED_SMC_ACTIVE_FLAG_MASK)
+#define set_queued_smc_active_flag(state)	(state |=		\
+					1 << QUEUED_SMC_ACTIVE_FLAG_SHIFT)
+#define clr_queued_smc_active_flag(state)	(state &=		\
+					~(QUEUED_SMC_ACTIVE_FLAG_MASK	\
+					<< QUEUED_SMC_ACTIVE_FLAG_SHIFT))
+
 /*******************************************************************************
  * Secure Payload execution state information i.e. aarch32 or aarch64
  ******************************************************************************/
@@ -225,6 +241,52 @@ int tspd_abort_preempted_smc(tsp_context_t *tsp_ctx);
 
 uint64_t tspd_handle_sp_preemption(void *handle);
 
+/* World switch latency accounting, see tspd_latency.c */
+#if TSPD_LATENCY_STATS
+void tspd_latency_start(unsigned int type);
+void tspd_latency_stop(unsigned int type);
+void tspd_latency_yield_preempted(void);
+void tspd_latency_yield_resumed(void);
+uintptr_t tspd_latency_stats_smc(void *handle, u_register_t type,
+				 u_register_t flags);
+#else
+static inline void tspd_latency_start(unsigned int type)
+{
+}
+
+static inline void tspd_latency_stop(unsigned int type)
+{
+}
+
+static inline void tspd_latency_yield_preempted(void)
+{
+}
+
+static inline void tspd_latency_yield_resumed(void)
+{
+}
+#endif
+
+/* Queuing of yielding SMCs to idle cpus, see tspd_queue.c */
+#if TSPD_YIELD_QUEUE
+void tspd_queue_init(void);
+uintptr_t tspd_queue_smc(void *handle, u_register_t fid, u_register_t arg1,
+			 u_register_t arg2);
+uintptr_t tspd_queue_result_smc(void *handle, u_register_t ticket);
+void __dead2 tspd_queue_smc_done(tsp_context_t *tsp_ctx, u_register_t x1,
+				 u_register_t x2, u_register_t x3);
+void tspd_queue_kick(void);
+void tspd_queue_cpu_off(void);
+#else
+static inline void tspd_queue_kick(void)
+{
+}
+
+static inline void tspd_queue_cpu_off(void)
+{
+}
+#endif
+
 extern tsp_context_t tspd_sp_context[TSPD_CORE_COUNT];
 extern tsp_vectors_t *tsp_vectors;
 #endif /*__ASSEMBLER__*/
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*******************************************************************************
+ * Queuing of yielding SMCs to idle cpus for the TSPD. With TSP_FID_QUEUE, a
+ * normal world client asks for a yielding TSP request to be run on another
+ * cpu, chosen among those whose TSP is on and neither running nor preempted
+ * in a yielding SMC. The request is posted in the slot of that cpu, which is
+ * signalled with an EL3 SGI and runs the request in its TSP the next time it
+ * takes the SGI from the normal world. The result is kept in the slot until
+ * the client reads it with TSP_FID_QUEUE_RESULT.
+ *
+ * If the platform defines PLAT_TSPD_QUEUE_SDEI_EVENT, the client is notified
+ * of the completion by the dispatch of that explicit SDEI event on the cpu it
+ * queued the request from.
+ ******************************************************************************/
+#include <assert.h>
+#include <stdbool.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <bl31/ehf.h>
+#include <bl32/tsp/tsp.h>
+#include <common/runtime_svc.h>
+#include <lib/el3_runtime/context_mgmt.h>
+#include <lib/el3_runtime/pubsub_events.h>
+#include <lib/spinlock.h>
+#include <plat/common/platform.h>
+#include <services/sdei.h>
+
+#include "tspd_private.h"
+
+#if SDEI_SUPPORT && defined(PLAT_TSPD_QUEUE_SDEI_EVENT)
+#define TSPD_QUEUE_NOTIFY	1
+#else
+#define TSPD_QUEUE_NOTIFY	0
+#endif
+
+/* States of the slot of a cpu */
+#define TSPD_QUEUE_FREE		U(0)
+#define TSPD_QUEUE_POSTED	U(1)
+#define TSPD_QUEUE_RUNNING	U(2)
+#define TSPD_QUEUE_DONE		U(3)
+
+typedef struct tspd_queue_slot {
+	unsigned int state;
+
+	/* cpu which queued the request */
+	unsigned int caller;
+
+	uint32_t fid;
+	u_register_t args[TSP_NUM_ARGS];
+	u_register_t results[3];
+
+	/* A request queued by this cpu has completed */
+	bool notify;
+} __aligned(CACHE_WRITEBACK_GRANULE) tspd_queue_slot_t;
+
+static tspd_queue_slot_t tspd_queue_slots[TSPD_CORE_COUNT];
+
+/* Protects the slots, and the choice of the cpu to post a request to */
+static spinlock_t tspd_queue_lock;
+
+/* cpu to consider first for the next request, to spread them out */
+static unsigned int tspd_queue_next;
+
+static void tspd_queue_raise_sgi(unsigned int cpu)
+{
+	plat_ic_raise_el3_sgi(PLAT_TSPD_QUEUE_SGI, tspd_sp_context[cpu].mpidr);
+}
+
+/* Mark the request of 'slot' as completed. Called with the lock held */
+static void tspd_queue_complete(tspd_queue_slot_t *slot)
+{
+	slot->state = TSPD_QUEUE_DONE;
+
+	if (TSPD_QUEUE_NOTIFY != 0) {
+		tspd_queue_slots[slot->caller].notify = true;
+		tspd_queue_raise_sgi(slot->caller);
+	}
+}
+
+/* A cpu can be posted a request if its TSP is on and idle */
+static bool tspd_queue_cpu_idle(unsigned int cpu)
+{
+	uint32_t state = tspd_sp_context[cpu].state;
+
+	return (get_tsp_pstate(state) == TSP_PSTATE_ON) &&
+	       (get_yield_smc_active_flag(state) == 0U) &&
+	       (tspd_queue_slots[cpu].state == TSPD_QUEUE_FREE);
+}
+
+/*******************************************************************************
+ * Run the request posted to this cpu in the TSP, through its fast SMC entry
+ * point so that it completes without being preempted. The normal world context
+ * interrupted by the SGI is preserved.
+ ******************************************************************************/
+static void tspd_queue_run(tsp_context_t *tsp_ctx, tspd_queue_slot_t *slot)
+{
+	uint64_t rc;
+
+	cm_el1_sysregs_context_save(NON_SECURE);
+
+	store_tsp_args(tsp_ctx, slot->args[0], slot->args[1]);
+	set_queued_smc_active_flag(tsp_ctx->state);
+
+	cm_set_elr_el3(SECURE, (uint64_t) &tsp_vectors->fast_smc_entry);
+	write_ctx_reg(get_gpregs_ctx(&tsp_ctx->cpu_ctx), CTX_GPREG_X0,
+		      slot->fid);
+	write_ctx_reg(get_gpregs_ctx(&tsp_ctx->cpu_ctx), CTX_GPREG_X1,
+		      slot->args[0]);
+	write_ctx_reg(get_gpregs_ctx(&tsp_ctx->cpu_ctx), CTX_GPREG_X2,
+		      slot->args[1]);
+
+	/* Returned through tspd_queue_smc_done() */
+	rc = tspd_synchronous_sp_entry(tsp_ctx);
+	if (rc != 0)
+		panic();
+
+	clr_queued_smc_active_flag(tsp_ctx->state);
+
+	cm_el1_sysregs_context_restore(NON_SECURE);
+	cm_set_next_eret_context(NON_SECURE);
+
+	spin_lock(&tspd_queue_lock);
+	tspd_queue_complete(slot);
+	spin_unlock(&tspd_queue_lock);
+}
+
+/*******************************************************************************
+ * Handler of the SGI signalling that a request has been posted to this cpu, or
+ * that a request queued by this cpu has completed. Both are deferred while the
+ * TSP is running, and a posted request also while the TSP is preempted in a
+ * yielding SMC, until tspd_queue_kick() raises the SGI again on the return to
+ * the normal world.
+ ******************************************************************************/
+static int tspd_queue_sgi_handler(uint32_t intr_raw, uint32_t flags,
+				  void *handle, void *cookie, void *arg)
+{
+	unsigned int cpu = plat_my_core_pos();
+	tsp_context_t *tsp_ctx = &tspd_sp_context[cpu];
+	tspd_queue_slot_t *slot = &tspd_queue_slots[cpu];
+	bool run = false;
+
+	plat_ic_end_of_interrupt(intr_raw);
+
+	if (get_interrupt_src_ss(flags) != NON_SECURE)
+		return 0;
+
+	assert(handle == cm_get_context(NON_SECURE));
+
+	spin_lock(&tspd_queue_lock);
+	if ((slot->state == TSPD_QUEUE_POSTED) &&
+	    (get_yield_smc_active_flag(tsp_ctx->state) == 0U)) {
+		slot->state = TSPD_QUEUE_RUNNING;
+		run = true;
+	}
+	spin_unlock(&tspd_queue_lock);
+
+	if (run)
+		tspd_queue_run(tsp_ctx, slot);
+
+#if TSPD_QUEUE_NOTIFY
+	/* Other cpus set the flag when completing requests of this one */
+	spin_lock(&tspd_queue_lock);
+	run = slot->notify;
+	slot->notify = false;
+	spin_unlock(&tspd_queue_lock);
+
+	if (run)
+		(void) sdei_dispatch_event(PLAT_TSPD_QUEUE_SDEI_EVENT);
+#endif
+
+	return 0;
+}
+
+void tspd_queue_init(void)
+{
+	ehf_register_interrupt_handler(PLAT_TSPD_QUEUE_SGI,
+				       tspd_queue_sgi_handler, NULL);
+}
+
+/*******************************************************************************
+ * Handler for TSP_FID_QUEUE. The cpus are considered in turn starting after
+ * the one posted the last request, and the calling cpu is never chosen: a
+ * client without any other idle cpu should issue the yielding SMC itself.
+ ******************************************************************************/
+uintptr_t tspd_queue_smc(void *handle, u_register_t fid, u_register_t arg1,
+			 u_register_t arg2)
+{
+	unsigned int caller = plat_my_core_pos();
+	unsigned int cpu = 0U, i;
+	tspd_queue_slot_t *slot = NULL;
+
+	switch (fid) {
+	case TSP_YIELD_FID(TSP_ADD):
+	case TSP_YIELD_FID(TSP_SUB):
+	case TSP_YIELD_FID(TSP_MUL):
+	case TSP_YIELD_FID(TSP_DIV):
+		break;
+	default:
+		SMC_RET1(handle, SMC_UNK);
+	}
+
+	spin_lock(&tspd_queue_lock);
+
+	for (i = 0U; i < TSPD_CORE_COUNT; i++) {
+		cpu = (tspd_queue_next + i) % TSPD_CORE_COUNT;
+		if ((cpu != caller) && tspd_queue_cpu_idle(cpu)) {
+			slot = &tspd_queue_slots[cpu];
+			break;
+		}
+	}
+
+	if (slot == NULL) {
+		spin_unlock(&tspd_queue_lock);
+		SMC_RET1(handle, TSP_QUEUE_BUSY);
+	}
+
+	slot->state = TSPD_QUEUE_POSTED;
+	slot->caller = caller;
+	slot->fid = (uint32_t) fid;
+	slot->args[0] = arg1;
+	slot->args[1] = arg2;
+	tspd_queue_next = cpu + 1U;
+
+	spin_unlock(&tspd_queue_lock);
+
+	tspd_queue_raise_sgi(cpu);
+
+	SMC_RET2(handle, SMC_OK, cpu);
+}
+
+/* Handler for TSP_FID_QUEUE_RESULT. The ticket is the target cpu */
+uintptr_t tspd_queue_result_smc(void *handle, u_register_t ticket)
+{
+	tspd_queue_slot_t *slot;
+	u_register_t results[3];
+
+	if (ticket >= TSPD_CORE_COUNT)
+		SMC_RET1(handle, SMC_UNK);
+
+	slot = &tspd_queue_slots[ticket];
+
+	spin_lock(&tspd_queue_lock);
+
+	if (slot->state == TSPD_QUEUE_FREE) {
+		spin_unlock(&tspd_queue_lock);
+		SMC_RET1(handle, SMC_UNK);
+	}
+
+	if (slot->state != TSPD_QUEUE_DONE) {
+		spin_unlock(&tspd_queue_lock);
+		SMC_RET1(handle, TSP_QUEUE_BUSY);
+	}
+
+	results[0] = slot->results[0];
+	results[1] = slot->results[1];
+	results[2] = slot->results[2];
+	slot->state = TSPD_QUEUE_FREE;
+
+	spin_unlock(&tspd_queue_lock);
+
+	SMC_RET3(handle, results[0], results[1], results[2]);
+}
+
+/* The TSP has returned the result of the request posted to this cpu */
+void tspd_queue_smc_done(tsp_context_t *tsp_ctx, u_register_t x1,
+			 u_register_t x2, u_register_t x3)
+{
+	tspd_queue_slot_t *slot = &tspd_queue_slots[plat_my_core_pos()];
+
+	assert(slot->state == TSPD_QUEUE_RUNNING);
+
+	slot->results[0] = x1;
+	slot->results[1] = x2;
+	slot->results[2] = x3;
+
+	tspd_synchronous_sp_exit(tsp_ctx, 0);
+}
+
+/*******************************************************************************
+ * Signal again the SGI deferred while this cpu was in the Secure world, if
+ * there is still work for it. Called on every return to the normal world, and
+ * by the TSPD once a yielding SMC has completed.
+ ******************************************************************************/
+void tspd_queue_kick(void)
+{
+	unsigned int cpu = plat_my_core_pos();
+	const tspd_queue_slot_t *slot = &tspd_queue_slots[cpu];
+
+	if (slot->notify ||
+	    ((slot->state == TSPD_QUEUE_POSTED) &&
+	     (get_yield_smc_active_flag(tspd_sp_context[cpu].state) == 0U)))
+		tspd_queue_raise_sgi(cpu);
+}
+
+/*
+ * The SGI is taken from the Secure world whenever it is raised while the TSP
+ * runs a fast SMC, an S-EL1 interrupt or a PSCI hook, and is dropped by the
+ * handler. Check for deferred work on every return to the normal world so that
+ * none of these paths can leave a request posted forever.
+ */
+static void *tspd_queue_entering_normal_world(const void *arg)
+{
+	tspd_queue_kick();
+
+	return (void *) arg;
+}
+
+SUBSCRIBE_TO_EVENT(cm_entering_normal_world, tspd_queue_entering_normal_world);
+
+/*******************************************************************************
+ * Called when this cpu is turned off, after its TSP has been marked off so that
+ * no more requests are posted to it. A request still posted is completed with
+ * SMC_UNK as result.
+ ******************************************************************************/
+void tspd_queue_cpu_off(void)
+{
+	tspd_queue_slot_t *slot = &tspd_queue_slots[plat_my_core_pos()];
+
+	spin_lock(&tspd_queue_lock);
+
+	if (slot->state == TSPD_QUEUE_POSTED) {
+		slot->results[0] = (u_register_t) SMC_UNK;
+		slot->results[1] = 0U;
+		slot->results[2] = 0U;
+		tspd_queue_complete(slot);
+	}
+
+	spin_unlock(&tspd_queue_lock);
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -12,6 +12,85 @@
 
 #define MAP_OFF(_map, _mapping) ((_map) - (_mapping)->map)
 
+/*
+ * Index of the mapping bound to each interrupt, so that interrupt dispatch
+ * doesn't have to search the mappings. Entries hold the position of the
+ * mapping plus one, counting the private mappings first and then the shared
+ * ones, or 0 if no mapping is bound to the interrupt. A single index serves
+ * both kinds of mappings, as private events can only be bound to private
+ * interrupts and shared events to shared interrupts.
+ *
+ * SDEI_DYN_IRQ, which unbound dynamic and explicit mappings also use, is never
+ * indexed. Lookups for it, and for interrupts beyond the end of the index,
+ * fall back to searching the mappings.
+ */
+static uint16_t sdei_intr_index[PLAT_SDEI_INTR_INDEX_SIZE];
+
+static unsigned int intr_index_value(sdei_ev_map_t *map)
+{
+	const sdei_mapping_t *mapping;
+
+	if (is_event_private(map)) {
+		mapping = SDEI_PRIVATE_MAPPING();
+		return (unsigned int) MAP_OFF(map, mapping) + 1U;
+	}
+
+	mapping = SDEI_SHARED_MAPPING();
+	return (unsigned int) (SDEI_PRIVATE_MAPPING()->num_maps +
+			MAP_OFF(map, mapping)) + 1U;
+}
+
+static bool is_intr_indexed(unsigned int intr_num)
+{
+	return (intr_num != SDEI_DYN_IRQ) &&
+		(intr_num < PLAT_SDEI_INTR_INDEX_SIZE);
+}
+
+/*
+ * Record the interrupt a mapping is bound to in the interrupt index. This must
+ * be called whenever a mapping gets bound to an interrupt.
+ */
+void sdei_intr_index_add(sdei_ev_map_t *map)
+{
+	if (!is_intr_indexed(map->intr))
+		return;
+
+	sdei_intr_index[map->intr] = (uint16_t) intr_index_value(map);
+}
+
+/*
+ * Remove the interrupt a mapping is bound to from the interrupt index. This
+ * must be called before the mapping is released from the interrupt.
+ */
+void sdei_intr_index_remove(sdei_ev_map_t *map)
+{
+	if (!is_intr_indexed(map->intr))
+		return;
+
+	if (sdei_intr_index[map->intr] == intr_index_value(map))
+		sdei_intr_index[map->intr] = 0U;
+}
+
+/* Index the interrupts of all the mappings bound at initialisation */
+void sdei_intr_index_init(void)
+{
+	unsigned int i;
+	sdei_ev_map_t *map;
+
+	assert((SDEI_PRIVATE_MAPPING()->num_maps +
+				SDEI_SHARED_MAPPING()->num_maps) < UINT16_MAX);
+
+	for_each_private_map(i, map) {
+		if ((map->ev_num == SDEI_EVENT_0) || is_map_bound(map))
+			sdei_intr_index_add(map);
+	}
+
+	for_each_shared_map(i, map) {
+		if (is_map_bound(map))
+			sdei_intr_index_add(map);
+	}
+}
+
 /*
  * Get SDEI entry with the given mapping: on success, returns pointer to SDEI
  * entry. On error, returns NULL.
@@ -57,16 +136,36 @@ sdei_entry_t *get_event_entry(sdei_ev_map_t *map)
  */
 sdei_ev_map_t *find_event_map_by_intr(unsigned int intr_num, bool shared)
 {
-	const sdei_mapping_t *mapping;
+	const sdei_mapping_t *priv, *mapping;
 	sdei_ev_map_t *map;
-	unsigned int i;
+	unsigned int i, idx;
+
+	mapping = shared ? SDEI_SHARED_MAPPING() : SDEI_PRIVATE_MAPPING();
+
+	if (is_intr_indexed(intr_num)) {
+		idx = sdei_intr_index[intr_num];
+		if (idx == 0U)
+			return NULL;
+
+		idx--;
+		priv = SDEI_PRIVATE_MAPPING();
+		if (idx < priv->num_maps) {
+			map = shared ? NULL : &priv->map[idx];
+		} else {
+			map = shared ? &mapping->map[idx - priv->num_maps] :
+				NULL;
+		}
+
+		/* The index is only updated along with the mappings */
+		assert((map == NULL) || (map->intr == intr_num));
+		return map;
+	}
 
 	/*
 	 * Look for a match in private and shared mappings, as requested. This
-	 * is a linear search. However, if the mappings are required to be
-	 * sorted, for large maps, we could consider binary search.
+	 * is a linear search, which is only needed for free dynamic mappings
+	 * or for interrupts beyond the index.
 	 */
-	mapping = shared ? SDEI_SHARED_MAPPING() : SDEI_PRIVATE_MAPPING();
 	iterate_mapping(mapping, i, map) {
 		if (map->intr == intr_num)
 			return map;
@@ -75,6 +174,31 @@ sdei_ev_map_t *find_event_map_by_intr(unsigned int intr_num, bool shared)
 	return NULL;
 }
 
+/*
+ * Binary search of a mapping for an event number. Mappings are sorted in
+ * increasing order of event number, which sdei_init() verifies.
+ */
+static sdei_ev_map_t *search_mapping(const sdei_mapping_t *mapping, int ev_num)
+{
+	size_t lo = 0U, hi = mapping->num_maps, mid;
+	sdei_ev_map_t *map;
+
+	while (lo < hi) {
+		mid = lo + ((hi - lo) / 2U);
+		map = &mapping->map[mid];
+
+		if (map->ev_num == ev_num)
+			return map;
+
+		if (map->ev_num < ev_num)
+			lo = mid + 1U;
+		else
+			hi = mid;
+	}
+
+	return NULL;
+}
+
 /*
  * Find event mapping for a given event number: On success returns pointer to
  * the event mapping. On error, returns NULL.
@@ -83,18 +207,12 @@ sdei_ev_map_t *find_event_map(int ev_num)
 {
 	const sdei_mapping_t *mapping;
 	sdei_ev_map_t *map;
-	unsigned int i, j;
+	unsigned int i;
 
-	/*
-	 * Iterate through mappings to find a match. This is a linear search.
-	 * However, if the mappings are required to be sorted, for large maps,
-	 * we could consider binary search.
-	 */
 	for_each_mapping_type(i, mapping) {
-		iterate_mapping(mapping, j, map) {
-			if (map->ev_num == ev_num)
-				return map;
-		}
+		map = search_mapping(mapping, ev_num);
+		if (map != NULL)
+			return map;
 	}
 
 	return NULL;
@@ -14,6 +14,7 @@
 #include <common/debug.h>
 #include <common/runtime_svc.h>
 #include <lib/cassert.h>
+#include <lib/el3_trace.h>
 #include <services/sdei.h>
 
 #include "sdei_private.h"
@@ -233,10 +234,11 @@ static cpu_context_t *restore_and_resume_ns_context(void)
 
 /*
  * Populate the Non-secure context so that the next ERET will dispatch to the
- * SDEI client.
+ * SDEI client. 'intr_ts' is the time the SDEI interrupt was taken, or 0 for
+ * explicit dispatches.
  */
 static void setup_ns_dispatch(sdei_ev_map_t *map, sdei_entry_t *se,
-		cpu_context_t *ctx, jmp_buf *dispatch_jmp)
+		cpu_context_t *ctx, jmp_buf *dispatch_jmp, uint64_t intr_ts)
 {
 	sdei_dispatch_context_t *disp_ctx;
 
@@ -279,6 +281,10 @@ static void setup_ns_dispatch(sdei_ev_map_t *map, sdei_entry_t *se,
 #endif
 
 	disp_ctx->dispatch_jmp = dispatch_jmp;
+
+	EL3_TRACE_EVENT(EL3_TRACE_EV_SDEI_DISPATCH, map->ev_num, map->intr);
+
+	sdei_latency_dispatch(map, intr_ts);
 }
 
 /* Handle a triggered SDEI interrupt while events were masked on this PE */
@@ -340,6 +346,7 @@ static void handle_masked_trigger(sdei_ev_map_t *map, sdei_entry_t *se,
 int sdei_intr_handler(uint32_t intr_raw, uint32_t flags, void *handle,
 		void *cookie)
 {
+	const uint64_t intr_ts = sdei_latency_intr_entry();
 	sdei_entry_t *se;
 	cpu_context_t *ctx;
 	sdei_ev_map_t *map;
@@ -481,7 +488,7 @@ int sdei_intr_handler(uint32_t intr_raw, uint32_t flags, void *handle,
 	}
 
 	/* Synchronously dispatch event */
-	setup_ns_dispatch(map, se, ctx, &dispatch_jmp);
+	setup_ns_dispatch(map, se, ctx, &dispatch_jmp, intr_ts);
 	begin_sdei_synchronous_dispatch(&dispatch_jmp);
 
 	/*
@@ -581,7 +588,7 @@ int sdei_dispatch_event(int ev_num)
 	ns_ctx = restore_and_resume_ns_context();
 
 	/* Dispatch event synchronously */
-	setup_ns_dispatch(map, se, ns_ctx, &dispatch_jmp);
+	setup_ns_dispatch(map, se, ns_ctx, &dispatch_jmp, 0U);
 	begin_sdei_synchronous_dispatch(&dispatch_jmp);
 
 	/*
@@ -635,6 +642,8 @@ int sdei_event_complete(bool resume, uint64_t pc)
 	if (is_event_shared(map))
 		sdei_map_unlock(map);
 
+	sdei_latency_complete(map);
+
 	/* Having done sanity checks, pop dispatch */
 	(void) pop_dispatch();
 
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*******************************************************************************
+ * SDEI dispatch latency accounting. PMF timestamps are captured when an SDEI
+ * interrupt enters the dispatcher, when the event is dispatched to the client,
+ * and when the client completes it. The intervals between them are sorted into
+ * per-PE histograms for each event class, so that gathering them involves no
+ * locking and no cache maintenance.
+ ******************************************************************************/
+#include <assert.h>
+
+#include <arch_helpers.h>
+#include <common/runtime_svc.h>
+#include <lib/latency_hist.h>
+#include <lib/pmf/pmf.h>
+#include <plat/common/platform.h>
+#include <services/sdei.h>
+
+#include "sdei_private.h"
+
+/* PMF timestamp IDs */
+#define SDEI_LAT_INTR_ENTRY		U(0)
+#define SDEI_LAT_DISPATCH_NORMAL	U(1)
+#define SDEI_LAT_DISPATCH_CRITICAL	U(2)
+#define SDEI_LAT_COMPLETE_NORMAL	U(3)
+#define SDEI_LAT_COMPLETE_CRITICAL	U(4)
+#define SDEI_LAT_TOTAL_IDS		U(5)
+
+PMF_REGISTER_SERVICE_SMC(sdei_svc, PMF_SDEI_SVC_ID, SDEI_LAT_TOTAL_IDS,
+	PMF_STORE_ENABLE)
+
+static latency_hist_t sdei_latency[PLATFORM_CORE_COUNT]
+		[SDEI_LATENCY_NUM_CLASSES][SDEI_LATENCY_NUM_METRICS];
+
+static unsigned int map_to_latency_class(sdei_ev_map_t *map)
+{
+	return is_event_critical(map) ? SDEI_LATENCY_CRITICAL :
+		SDEI_LATENCY_NORMAL;
+}
+
+/*
+ * Called on entry into the SDEI interrupt handler. Returns the timestamp to
+ * pass to sdei_latency_dispatch() if the interrupt leads to a dispatch.
+ */
+uint64_t sdei_latency_intr_entry(void)
+{
+	unsigned long long ts;
+
+	PMF_CAPTURE_AND_GET_TIMESTAMP(sdei_svc, SDEI_LAT_INTR_ENTRY,
+			PMF_NO_CACHE_MAINT, ts);
+
+	return ts;
+}
+
+/*
+ * Called once the Non-secure context is ready for dispatching the event.
+ * 'intr_ts' is 0 for explicit dispatches, which don't originate from an
+ * interrupt.
+ */
+void sdei_latency_dispatch(sdei_ev_map_t *map, uint64_t intr_ts)
+{
+	unsigned int class = map_to_latency_class(map);
+	unsigned long long ts;
+
+	PMF_CAPTURE_AND_GET_TIMESTAMP(sdei_svc,
+			SDEI_LAT_DISPATCH_NORMAL + class, PMF_NO_CACHE_MAINT,
+			ts);
+
+	if (intr_ts != 0U) {
+		latency_hist_record(&sdei_latency[plat_my_core_pos()][class]
+				[SDEI_LATENCY_DISPATCH], ts - intr_ts);
+	}
+}
+
+/* Called when the client completes the event */
+void sdei_latency_complete(sdei_ev_map_t *map)
+{
+	unsigned int class = map_to_latency_class(map);
+	unsigned int cpu = plat_my_core_pos();
+	unsigned long long ts, dispatch_ts;
+
+	PMF_CAPTURE_AND_GET_TIMESTAMP(sdei_svc,
+			SDEI_LAT_COMPLETE_NORMAL + class, PMF_NO_CACHE_MAINT,
+			ts);
+	PMF_GET_TIMESTAMP_BY_INDEX(sdei_svc, SDEI_LAT_DISPATCH_NORMAL + class,
+			cpu, PMF_NO_CACHE_MAINT, dispatch_ts);
+
+	latency_hist_record(&sdei_latency[cpu][class][SDEI_LATENCY_HANDLER],
+			ts - dispatch_ts);
+}
+
+/*
+ * Report the statistics of one class of events and one interval, merged across
+ * all PEs. x1 holds the number of samples, and x2-x5 the minimum, median, 99th
+ * percentile and maximum latencies in system counter ticks. Resetting the
+ * statistics is only safe while no SDEI event is being dispatched.
+ */
+uintptr_t sdei_latency_stats_smc(void *handle, u_register_t ev_class,
+		u_register_t metric, u_register_t flags)
+{
+	latency_hist_t hist;
+	unsigned int i;
+
+	if ((ev_class >= SDEI_LATENCY_NUM_CLASSES) ||
+			(metric >= SDEI_LATENCY_NUM_METRICS))
+		SMC_RET1(handle, SMC_UNK);
+
+	latency_hist_reset(&hist);
+	for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		latency_hist_merge(&hist, &sdei_latency[i][ev_class][metric]);
+
+		if ((flags & SDEI_LATENCY_FLAG_RESET) != 0U)
+			latency_hist_reset(&sdei_latency[i][ev_class][metric]);
+	}
+
+	SMC_RET6(handle, SMC_OK, hist.count,
+		 latency_hist_percentile(&hist, 0U),
+		 latency_hist_percentile(&hist, 50U),
+		 latency_hist_percentile(&hist, 99U),
+		 latency_hist_percentile(&hist, 100U));
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -229,6 +229,9 @@ void sdei_init(void)
 	sdei_class_init(SDEI_CRITICAL);
 	sdei_class_init(SDEI_NORMAL);
 
+	/* Index the statically bound interrupts for event dispatch */
+	sdei_intr_index_init();
+
 	/* Register priority level handlers */
 	ehf_register_priority_handler(PLAT_SDEI_CRITICAL_PRI,
 			sdei_intr_handler);
@@ -745,6 +748,7 @@ static int sdei_interrupt_bind(unsigned int intr_num)
 		if (!is_map_bound(map)) {
 			map->intr = intr_num;
 			set_map_bound(map);
+			sdei_intr_index_add(map);
 			retry = false;
 		}
 		sdei_map_unlock(map);
@@ -802,6 +806,7 @@ static int sdei_interrupt_release(int ev_num)
 		 * during unregister.
 		 */
 
+		sdei_intr_index_remove(map);
 		map->intr = SDEI_DYN_IRQ;
 		clr_map_bound(map);
 	} else {
@@ -64,6 +64,14 @@
 #define SDEI_INFO_EV_ROUTING_MODE	3
 #define SDEI_INFO_EV_ROUTING_AFF	4
 
+/*
+ * Interrupts with an ID below this value are found through a direct index when
+ * dispatching SDEI events. The default covers the SGIs, PPIs and SPIs of a GIC.
+ */
+#ifndef PLAT_SDEI_INTR_INDEX_SIZE
+#define PLAT_SDEI_INTR_INDEX_SIZE	U(1020)
+#endif
+
 #define SDEI_PRIVATE_MAPPING()	(&sdei_global_mappings[SDEI_MAP_IDX_PRIV_])
 #define SDEI_SHARED_MAPPING()	(&sdei_global_mappings[SDEI_MAP_IDX_SHRD_])
 
@@ -231,6 +239,9 @@ extern sdei_entry_t sdei_shared_event_table[];
 void init_sdei_state(void);
 
 sdei_ev_map_t *find_event_map_by_intr(unsigned int intr_num, bool shared);
+void sdei_intr_index_init(void);
+void sdei_intr_index_add(sdei_ev_map_t *map);
+void sdei_intr_index_remove(sdei_ev_map_t *map);
 sdei_ev_map_t *find_event_map(int ev_num);
 sdei_entry_t *get_event_entry(sdei_ev_map_t *map);
 
@@ -242,6 +253,27 @@ int64_t sdei_pe_mask(void);
 
 int sdei_intr_handler(uint32_t intr_raw, uint32_t flags, void *handle,
 		void *cookie);
+
+/* Dispatch latency accounting, see sdei_latency.c */
+#if SDEI_LATENCY_STATS
+uint64_t sdei_latency_intr_entry(void);
+void sdei_latency_dispatch(sdei_ev_map_t *map, uint64_t intr_ts);
+void sdei_latency_complete(sdei_ev_map_t *map);
+#else
+static inline uint64_t sdei_latency_intr_entry(void)
+{
+	return 0U;
+}
+
+static inline void sdei_latency_dispatch(sdei_ev_map_t *map,
+		uint64_t intr_ts)
+{
+}
+
+static inline void sdei_latency_complete(sdei_ev_map_t *map)
+{
+}
+#endif
 bool can_sdei_state_trans(sdei_entry_t *se, sdei_action_t act);
 void begin_sdei_synchronous_dispatch(jmp_buf *buffer);
 
@@ -6,14 +6,17 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include <common/debug.h>
 #include <common/runtime_svc.h>
+#include <lib/cassert.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/smccc.h>
 #include <lib/spinlock.h>
 #include <lib/utils.h>
+#include <lib/xlat_tables/xlat_tables_v2.h>
 #include <services/spci_svc.h>
 #include <services/sprt_svc.h>
 #include <smccc_helpers.h>
@@ -30,6 +33,14 @@
 /*******************************************************************************
  * Array of structs that contains information about all handles of Secure
  * Services that are currently open.
+ *
+ * A handle value encodes the index of its entry in the array and the generation
+ * of the entry, incremented every time a handle is closed, so looking up a
+ * handle doesn't need a search and stale handles are rejected. Each entry has
+ * its own lock, so that requests to different handles don't contend.
+ * spci_handles_lock only serializes opening and closing handles, and is always
+ * taken before the lock of an entry. It is never held while waiting for a
+ * partition.
  ******************************************************************************/
 typedef enum spci_handle_status {
 	HANDLE_STATUS_CLOSED = 0,
@@ -37,12 +48,21 @@ typedef enum spci_handle_status {
 } spci_handle_status_t;
 
 typedef struct spci_handle {
+	/* Lock that protects the fields below, except the ring mapping */
+	spinlock_t lock;
+
 	/* 16-bit value used as reference in all SPCI calls */
 	uint16_t handle;
 
 	/* Client ID of the client that requested the handle */
 	uint16_t client_id;
 
+	/* Number of times a handle of this entry has been closed */
+	uint16_t generation;
+
+	/* Number of requests done with this handle */
+	uint16_t token_count;
+
 	/* Current status of the handle */
 	spci_handle_status_t status;
 
@@ -57,70 +77,118 @@ typedef struct spci_handle {
 	 * counter of them.
 	 */
 	unsigned int num_active_requests;
+
+	/* Size of the ring registered with this handle, 0 if there isn't any */
+	size_t ring_size;
+
+	/*
+	 * A ring is being registered with this handle. The handle can't be
+	 * closed meanwhile, and the CPU registering it owns the ring mapping.
+	 */
+	bool ring_updating;
+
+	/*
+	 * Ring mapped for this entry of the array, and partition where it is
+	 * mapped. It stays mapped after the handle is closed, until the entry
+	 * is reused to register another ring, so that notifications of the ring
+	 * still queued in the partition don't make it fault. Only accessed by
+	 * the CPU that has set ring_updating.
+	 */
+	sp_context_t *ring_map_sp_ctx;
+	size_t ring_map_size;
 } spci_handle_t;
 
+/* Number of generations of an entry that fit in a 16-bit handle value */
+#define SPCI_HANDLE_GENERATIONS	(U(0x10000) / PLAT_SPCI_HANDLES_MAX_NUM)
+
+CASSERT(SPCI_HANDLE_GENERATIONS >= 2U, assert_spci_handles_max_num_too_big);
+
 static spci_handle_t spci_handles[PLAT_SPCI_HANDLES_MAX_NUM];
 static spinlock_t spci_handles_lock;
 
+/*
+ * Indices of the closed entries of the array that have been used before, and
+ * number of entries that have never been used.
+ */
+static uint16_t spci_handles_free[PLAT_SPCI_HANDLES_MAX_NUM];
+static unsigned int spci_handles_free_count;
+static unsigned int spci_handles_used_count;
+
 /*
  * Given a handle and a client ID, return the element of the spci_handles
- * array that contains the information of the handle. It can only return open
- * handles. It returns NULL if it couldn't find the element in the array.
+ * array that contains the information of the handle, with its lock held. It
+ * can only return open handles. It returns NULL if the handle isn't valid.
  */
 static spci_handle_t *spci_handle_info_get(uint16_t handle, uint16_t client_id)
 {
-	size_t i;
+	spci_handle_t *h;
 
-	for (i = 0; i < ARRAY_SIZE(spci_handles); i++) {
-		spci_handle_t *h = &(spci_handles[i]);
+	if (handle >= (SPCI_HANDLE_GENERATIONS * PLAT_SPCI_HANDLES_MAX_NUM)) {
+		return NULL;
+	}
 
-		/* Only check for open handles */
-		if (h->status == HANDLE_STATUS_CLOSED) {
-			continue;
-		}
+	h = &(spci_handles[handle % PLAT_SPCI_HANDLES_MAX_NUM]);
 
-		/* Check if either the handle or the client ID are different */
-		if ((h->handle != handle) || (h->client_id != client_id)) {
-			continue;
-		}
+	spin_lock(&(h->lock));
 
-		return h;
+	/* Check the status, generation and client ID of the entry */
+	if ((h->status != HANDLE_STATUS_OPEN) || (h->handle != handle) ||
+	    (h->client_id != client_id)) {
+		spin_unlock(&(h->lock));
+		return NULL;
 	}
 
-	return NULL;
+	return h;
 }
 
 /*
- * Returns a unique value for a handle. This function must be called while
- * spci_handles_lock is locked. It returns 0 on success, -1 on error.
+ * Returns the index of a closed entry of the spci_handles array. This function
+ * must be called while spci_handles_lock is locked. It returns 0 on success,
+ * -1 if all entries are in use.
  */
-static int spci_create_handle_value(uint16_t *handle)
+static int spci_handle_alloc(unsigned int *index)
 {
-	/*
-	 * Trivial implementation that relies on the fact that any handle will
-	 * be closed before 2^16 more handles have been opened.
-	 */
-	static uint16_t handle_count;
+	if (spci_handles_free_count > 0U) {
+		spci_handles_free_count--;
+		*index = spci_handles_free[spci_handles_free_count];
+		return 0;
+	}
 
-	*handle = handle_count;
+	if (spci_handles_used_count < PLAT_SPCI_HANDLES_MAX_NUM) {
+		*index = spci_handles_used_count;
+		spci_handles_used_count++;
+		return 0;
+	}
 
-	handle_count++;
+	return -1;
+}
 
-	return 0;
+/*
+ * Returns the value of the next handle of an entry of the spci_handles array.
+ * The entry must be closed.
+ */
+static uint16_t spci_create_handle_value(unsigned int index)
+{
+	return (uint16_t)((spci_handles[index].generation *
+			   PLAT_SPCI_HANDLES_MAX_NUM) + index);
 }
 
 /*******************************************************************************
- * Returns a unique token for a Secure Service request.
+ * Returns a unique token for a Secure Service request done with a handle. This
+ * function must be called while the lock of the handle is locked.
  ******************************************************************************/
-static uint32_t spci_create_token_value(void)
+static uint32_t spci_create_token_value(spci_handle_t *h)
 {
 	/*
-	 * Trivial implementation that relies on the fact that any response will
-	 * be read before 2^32 more service requests have been done.
+	 * The handle values of open handles are unique, so tokens are unique as
+	 * long as any response is read before 2^16 more service requests have
+	 * been done with the same handle.
 	 */
-	static uint32_t token_count;
+	uint32_t token = ((uint32_t)h->token_count << 16) | h->handle;
+
+	h->token_count++;
 
-	return token_count++;
+	return token;
 }
 
 /*******************************************************************************
@@ -134,6 +202,7 @@ static uint64_t spci_service_handle_open_poll(void *handle, u_register_t x1,
 {
 	unsigned int i;
 	sp_context_t *sp_ptr;
+	spci_handle_t *h;
 	uint16_t service_handle;
 
 	/* Bits 31:16 of w7 are reserved (MBZ). */
@@ -153,20 +222,17 @@ static uint64_t spci_service_handle_open_poll(void *handle, u_register_t x1,
 		SMC_RET2(handle, SPCI_NOT_PRESENT, 0);
 	}
 
+	/* Initialize the partition if no CPU has started doing it yet */
+	spm_sp_init_if_pending(sp_ptr);
+
 	/* Get lock of the array of handles */
 	spin_lock(&spci_handles_lock);
 
 	/*
 	 * We need to record the client ID and Secure Partition that correspond
-	 * to this handle. Look for the first free entry in the array.
+	 * to this handle. Get a free entry in the array.
 	 */
-	for (i = 0; i < PLAT_SPCI_HANDLES_MAX_NUM; i++) {
-		if (spci_handles[i].status == HANDLE_STATUS_CLOSED) {
-			break;
-		}
-	}
-
-	if (i == PLAT_SPCI_HANDLES_MAX_NUM) {
+	if (spci_handle_alloc(&i) != 0) {
 		spin_unlock(&spci_handles_lock);
 
 		WARN("SPCI: Can't open more handles. Client 0x%04x\n",
@@ -178,23 +244,21 @@ static uint64_t spci_service_handle_open_poll(void *handle, u_register_t x1,
 	}
 
 	/* Create new handle value */
-	if (spci_create_handle_value(&service_handle) != 0) {
-		spin_unlock(&spci_handles_lock);
-
-		WARN("SPCI: Can't create a new handle value. Client 0x%04x\n",
-		     client_id);
-		WARN("SPCI:   UUID: " PRINT_UUID_FORMAT "\n",
-		     PRINT_UUID_ARGS(uuid));
-
-		SMC_RET2(handle, SPCI_NO_MEMORY, 0);
-	}
+	service_handle = spci_create_handle_value(i);
 
 	/* Save all information about this handle */
-	spci_handles[i].status = HANDLE_STATUS_OPEN;
-	spci_handles[i].client_id = client_id;
-	spci_handles[i].handle = service_handle;
-	spci_handles[i].num_active_requests = 0U;
-	spci_handles[i].sp_ctx = sp_ptr;
+	h = &(spci_handles[i]);
+
+	spin_lock(&(h->lock));
+	h->status = HANDLE_STATUS_OPEN;
+	h->client_id = client_id;
+	h->handle = service_handle;
+	h->num_active_requests = 0U;
+	h->token_count = 0U;
+	h->ring_size = 0U;
+	h->ring_updating = false;
+	h->sp_ctx = sp_ptr;
+	spin_unlock(&(h->lock));
 
 	/* Release lock of the array of handles */
 	spin_unlock(&spci_handles_lock);
@@ -230,16 +294,8 @@ static uint64_t spci_service_handle_close(void *handle, u_register_t x1)
 		SMC_RET1(handle, SPCI_INVALID_PARAMETER);
 	}
 
-	if (handle_info->status != HANDLE_STATUS_OPEN) {
-		spin_unlock(&spci_handles_lock);
-
-		WARN("SPCI: Tried to close handle 0x%04x by client 0x%04x in status %d\n",
-			service_handle, client_id, handle_info->status);
-
-		SMC_RET1(handle, SPCI_INVALID_PARAMETER);
-	}
-
 	if (handle_info->num_active_requests != 0U) {
+		spin_unlock(&(handle_info->lock));
 		spin_unlock(&spci_handles_lock);
 
 		/* A handle can't be closed if there are requests left */
@@ -250,9 +306,29 @@ static uint64_t spci_service_handle_close(void *handle, u_register_t x1)
 		SMC_RET1(handle, SPCI_BUSY);
 	}
 
-	memset(handle_info, 0, sizeof(spci_handle_t));
+	if (handle_info->ring_updating) {
+		spin_unlock(&(handle_info->lock));
+		spin_unlock(&spci_handles_lock);
+
+		WARN("SPCI: Tried to close handle 0x%04x by client 0x%04x while registering its ring\n",
+		     service_handle, client_id);
+
+		SMC_RET1(handle, SPCI_BUSY);
+	}
 
 	handle_info->status = HANDLE_STATUS_CLOSED;
+	handle_info->client_id = 0U;
+	handle_info->sp_ctx = NULL;
+
+	/* Don't give the same handle value to the next user of the entry */
+	handle_info->generation = (handle_info->generation + 1U) %
+				  SPCI_HANDLE_GENERATIONS;
+
+	spin_unlock(&(handle_info->lock));
+
+	spci_handles_free[spci_handles_free_count] =
+		(uint16_t)(handle_info - spci_handles);
+	spci_handles_free_count++;
 
 	spin_unlock(&spci_handles_lock);
 
@@ -263,37 +339,18 @@ static uint64_t spci_service_handle_close(void *handle, u_register_t x1)
 }
 
 /*******************************************************************************
- * This function requests a Secure Service from a given handle and client ID.
+ * This function passes a message to the Secure Partition that provides the
+ * service of a handle through its blocking queue, and waits for the partition
+ * to process it. It must be called with the lock of the handle held, which it
+ * releases.
  ******************************************************************************/
-static uint64_t spci_service_request_blocking(void *handle,
-			uint32_t smc_fid, u_register_t x1, u_register_t x2,
-			u_register_t x3, u_register_t x4, u_register_t x5,
-			u_register_t x6, u_register_t x7)
+static uint64_t spci_request_blocking(void *handle, spci_handle_t *handle_info,
+			const struct sprt_queue_entry_message *message)
 {
-	spci_handle_t *handle_info;
 	sp_context_t *sp_ctx;
 	cpu_context_t *cpu_ctx;
 	uint32_t rx0;
 	u_register_t rx1, rx2, rx3;
-	uint16_t request_handle, client_id;
-
-	/* Get handle array lock */
-	spin_lock(&spci_handles_lock);
-
-	/* Get pointer to struct of this open handle and client ID. */
-	request_handle = (x7 >> 16U) & 0x0000FFFFU;
-	client_id = x7 & 0x0000FFFFU;
-
-	handle_info = spci_handle_info_get(request_handle, client_id);
-	if (handle_info == NULL) {
-		spin_unlock(&spci_handles_lock);
-
-		WARN("SPCI_SERVICE_TUN_REQUEST_BLOCKING: Not found.\n");
-		WARN("  Handle 0x%04x. Client ID 0x%04x\n", request_handle,
-		     client_id);
-
-		SMC_RET1(handle, SPCI_BUSY);
-	}
 
 	/* Get pointer to the Secure Partition that handles the service */
 	sp_ctx = handle_info->sp_ctx;
@@ -302,13 +359,13 @@ static uint64_t spci_service_request_blocking(void *handle,
 
 	/* Blocking requests are only allowed if the queue is empty */
 	if (handle_info->num_active_requests > 0) {
-		spin_unlock(&spci_handles_lock);
+		spin_unlock(&(handle_info->lock));
 
 		SMC_RET1(handle, SPCI_BUSY);
 	}
 
 	if (spm_sp_request_increase_if_zero(sp_ctx) == -1) {
-		spin_unlock(&spci_handles_lock);
+		spin_unlock(&(handle_info->lock));
 
 		SMC_RET1(handle, SPCI_BUSY);
 	}
@@ -317,7 +374,7 @@ static uint64_t spci_service_request_blocking(void *handle,
 	handle_info->num_active_requests += 1;
 
 	/* Release handle lock */
-	spin_unlock(&spci_handles_lock);
+	spin_unlock(&(handle_info->lock));
 
 	/* Save the Normal world context */
 	cm_el1_sysregs_context_save(NON_SECURE);
@@ -326,17 +383,8 @@ static uint64_t spci_service_request_blocking(void *handle,
 	sp_state_wait_switch(sp_ctx, SP_STATE_IDLE, SP_STATE_BUSY);
 
 	/* Pass arguments to the Secure Partition */
-	struct sprt_queue_entry_message message = {
-		.type = SPRT_MSG_TYPE_SERVICE_TUN_REQUEST,
-		.client_id = client_id,
-		.service_handle = request_handle,
-		.session_id = x6,
-		.token = 0, /* No token needed for blocking requests */
-		.args = {smc_fid, x1, x2, x3, x4, x5}
-	};
-
 	spin_lock(&(sp_ctx->spm_sp_buffer_lock));
-	int rc = sprt_push_message((void *)sp_ctx->spm_sp_buffer_base, &message,
+	int rc = sprt_push_message((void *)sp_ctx->spm_sp_buffer_base, message,
 				   SPRT_QUEUE_NUM_BLOCKING);
 	spin_unlock(&(sp_ctx->spm_sp_buffer_lock));
 	if (rc != 0) {
@@ -345,7 +393,7 @@ static uint64_t spci_service_request_blocking(void *handle,
 		 * the request queue is empty.
 		 */
 		assert(rc == -ENOMEM);
-		ERROR("SPCI_SERVICE_TUN_REQUEST_BLOCKING: Queue is full.\n");
+		ERROR("SPCI: Blocking request queue is full.\n");
 		panic();
 	}
 
@@ -367,9 +415,9 @@ static uint64_t spci_service_request_blocking(void *handle,
 	sp_state_set(sp_ctx, SP_STATE_IDLE);
 
 	/* Decrease count of requests. */
-	spin_lock(&spci_handles_lock);
+	spin_lock(&(handle_info->lock));
 	handle_info->num_active_requests -= 1;
-	spin_unlock(&spci_handles_lock);
+	spin_unlock(&(handle_info->lock));
 	spm_sp_request_decrease(sp_ctx);
 
 	/* Restore non-secure state */
@@ -379,6 +427,42 @@ static uint64_t spci_service_request_blocking(void *handle,
 	SMC_RET4(handle, SPCI_SUCCESS, rx1, rx2, rx3);
 }
 
+/*******************************************************************************
+ * This function requests a Secure Service from a given handle and client ID.
+ ******************************************************************************/
+static uint64_t spci_service_request_blocking(void *handle,
+			uint32_t smc_fid, u_register_t x1, u_register_t x2,
+			u_register_t x3, u_register_t x4, u_register_t x5,
+			u_register_t x6, u_register_t x7)
+{
+	spci_handle_t *handle_info;
+	uint16_t request_handle, client_id;
+
+	/* Get pointer to struct of this open handle and client ID. */
+	request_handle = (x7 >> 16U) & 0x0000FFFFU;
+	client_id = x7 & 0x0000FFFFU;
+
+	handle_info = spci_handle_info_get(request_handle, client_id);
+	if (handle_info == NULL) {
+		WARN("SPCI_SERVICE_TUN_REQUEST_BLOCKING: Not found.\n");
+		WARN("  Handle 0x%04x. Client ID 0x%04x\n", request_handle,
+		     client_id);
+
+		SMC_RET1(handle, SPCI_BUSY);
+	}
+
+	struct sprt_queue_entry_message message = {
+		.type = SPRT_MSG_TYPE_SERVICE_TUN_REQUEST,
+		.client_id = client_id,
+		.service_handle = request_handle,
+		.session_id = x6,
+		.token = 0, /* No token needed for blocking requests */
+		.args = {smc_fid, x1, x2, x3, x4, x5}
+	};
+
+	return spci_request_blocking(handle, handle_info, &message);
+}
+
 /*******************************************************************************
  * This function handles the returned values from the Secure Partition.
  ******************************************************************************/
@@ -428,17 +512,12 @@ static uint64_t spci_service_request_start(void *handle,
 	uint16_t request_handle, client_id;
 	uint32_t token;
 
-	/* Get handle array lock */
-	spin_lock(&spci_handles_lock);
-
 	/* Get pointer to struct of this open handle and client ID. */
 	request_handle = (x7 >> 16U) & 0x0000FFFFU;
 	client_id = x7 & 0x0000FFFFU;
 
 	handle_info = spci_handle_info_get(request_handle, client_id);
 	if (handle_info == NULL) {
-		spin_unlock(&spci_handles_lock);
-
 		WARN("SPCI_SERVICE_TUN_REQUEST_START: Not found.\n"
 		     "  Handle 0x%04x. Client ID 0x%04x\n", request_handle,
 		     client_id);
@@ -457,10 +536,10 @@ static uint64_t spci_service_request_start(void *handle,
 	spm_sp_request_increase(sp_ctx);
 
 	/* Create new token for this request */
-	token = spci_create_token_value();
+	token = spci_create_token_value(handle_info);
 
 	/* Release handle lock */
-	spin_unlock(&spci_handles_lock);
+	spin_unlock(&(handle_info->lock));
 
 	/* Pass arguments to the Secure Partition */
 	struct sprt_queue_entry_message message = {
@@ -532,11 +611,8 @@ static uint64_t spci_service_request_resume(void *handle, u_register_t x1,
 	uint16_t service_handle = (x7 >> 16) & 0x0000FFFF;
 
 	/* Get pointer to struct of this open handle and client ID. */
-	spin_lock(&spci_handles_lock);
-
 	handle_info = spci_handle_info_get(service_handle, client_id);
 	if (handle_info == NULL) {
-		spin_unlock(&spci_handles_lock);
 		WARN("SPCI_SERVICE_REQUEST_RESUME: Not found.\n"
 		     "Handle 0x%04x. Client ID 0x%04x, Token 0x%08x.\n",
 		     client_id, service_handle, token);
@@ -549,16 +625,16 @@ static uint64_t spci_service_request_resume(void *handle, u_register_t x1,
 	assert(sp_ctx != NULL);
 	cpu_ctx = &(sp_ctx->cpu_ctx);
 
-	spin_unlock(&spci_handles_lock);
+	spin_unlock(&(handle_info->lock));
 
 	/* Look for a valid response in the global queue */
 	rc = spm_response_get(client_id, service_handle, token,
 			      &rx1, &rx2, &rx3);
 	if (rc == 0) {
 		/* Decrease request count */
-		spin_lock(&spci_handles_lock);
+		spin_lock(&(handle_info->lock));
 		handle_info->num_active_requests -= 1;
-		spin_unlock(&spci_handles_lock);
+		spin_unlock(&(handle_info->lock));
 		spm_sp_request_decrease(sp_ctx);
 
 		SMC_RET4(handle, SPCI_SUCCESS, rx1, rx2, rx3);
@@ -600,9 +676,9 @@ static uint64_t spci_service_request_resume(void *handle, u_register_t x1,
 	}
 
 	/* Decrease request count */
-	spin_lock(&spci_handles_lock);
+	spin_lock(&(handle_info->lock));
 	handle_info->num_active_requests -= 1;
-	spin_unlock(&spci_handles_lock);
+	spin_unlock(&(handle_info->lock));
 	spm_sp_request_decrease(sp_ctx);
 
 	/* Return response */
@@ -625,12 +701,8 @@ static uint64_t spci_service_get_response(void *handle, u_register_t x1,
 	uint16_t service_handle = (x7 >> 16) & 0x0000FFFF;
 
 	/* Get pointer to struct of this open handle and client ID. */
-
-	spin_lock(&spci_handles_lock);
-
 	handle_info = spci_handle_info_get(service_handle, client_id);
 	if (handle_info == NULL) {
-		spin_unlock(&spci_handles_lock);
 		WARN("SPCI_SERVICE_GET_RESPONSE: Not found.\n"
 		     "Handle 0x%04x. Client ID 0x%04x, Token 0x%08x.\n",
 		     client_id, service_handle, token);
@@ -638,7 +710,7 @@ static uint64_t spci_service_get_response(void *handle, u_register_t x1,
 		SMC_RET1(handle, SPCI_INVALID_PARAMETER);
 	}
 
-	spin_unlock(&spci_handles_lock);
+	spin_unlock(&(handle_info->lock));
 
 	/* Look for a valid response in the global queue */
 	rc = spm_response_get(client_id, service_handle, token,
@@ -649,17 +721,245 @@ static uint64_t spci_service_get_response(void *handle, u_register_t x1,
 	}
 
 	/* Decrease request count */
-	spin_lock(&spci_handles_lock);
+	spin_lock(&(handle_info->lock));
 	handle_info->num_active_requests -= 1;
 	sp_context_t *sp_ctx;
 	sp_ctx = handle_info->sp_ctx;
-	spin_unlock(&spci_handles_lock);
+	spin_unlock(&(handle_info->lock));
 	spm_sp_request_decrease(sp_ctx);
 
 	/* Return response */
 	SMC_RET4(handle, SPCI_SUCCESS, rx1, rx2, rx3);
 }
 
+/*******************************************************************************
+ * Returns the VA where the ring of an entry of the spci_handles array is mapped
+ * in a Secure Partition, and the maximum size of the ring. The client ring
+ * region of the partition is split evenly between all entries.
+ ******************************************************************************/
+static uintptr_t spci_ring_va(const sp_context_t *sp_ctx, unsigned int index,
+			      size_t *max_size)
+{
+	size_t slot_size = (sp_ctx->ring_va_size /
+			    PLAT_SPCI_HANDLES_MAX_NUM) & ~PAGE_SIZE_MASK;
+
+	*max_size = slot_size;
+
+	return sp_ctx->ring_va_base + ((uintptr_t)index * slot_size);
+}
+
+/*******************************************************************************
+ * This function maps a ring of Non-secure memory in the Secure Partition that
+ * provides the service of a handle. Once registered, the client notifies the
+ * partition of new requests in the ring with SPCI_SERVICE_RING_DOORBELL, and
+ * the partition returns the responses through the ring. It returns an SPCI_***
+ * error code.
+ ******************************************************************************/
+static uint64_t spci_service_ring_register(void *handle, u_register_t x1,
+					   u_register_t x2, u_register_t x7)
+{
+	spci_handle_t *handle_info;
+	sp_context_t *sp_ctx;
+	unsigned int index;
+	uintptr_t ring_va;
+	size_t max_size;
+	unsigned long long ring_pa = x1;
+	size_t ring_size = x2;
+	uint16_t client_id = x7 & 0x0000FFFFU;
+	uint16_t service_handle = (x7 >> 16) & 0x0000FFFFU;
+	uint64_t ret = SPCI_SUCCESS;
+
+	if ((ring_size == 0U) || !IS_PAGE_ALIGNED(ring_pa) ||
+	    !IS_PAGE_ALIGNED(ring_size)) {
+		SMC_RET1(handle, SPCI_INVALID_PARAMETER);
+	}
+
+	handle_info = spci_handle_info_get(service_handle, client_id);
+	if (handle_info == NULL) {
+		WARN("SPCI_SERVICE_RING_REGISTER: Not found.\n"
+		     "  Handle 0x%04x. Client ID 0x%04x\n", service_handle,
+		     client_id);
+
+		SMC_RET1(handle, SPCI_INVALID_PARAMETER);
+	}
+
+	sp_ctx = handle_info->sp_ctx;
+	index = handle_info - spci_handles;
+	ring_va = spci_ring_va(sp_ctx, index, &max_size);
+
+	if ((handle_info->ring_size != 0U) || handle_info->ring_updating) {
+		ret = SPCI_BUSY;
+	} else if (ring_size > max_size) {
+		ret = (max_size == 0U) ? SPCI_NOT_SUPPORTED : SPCI_NO_MEMORY;
+	} else {
+		/* Prevent the handle from being closed while mapping the ring */
+		handle_info->ring_updating = true;
+	}
+
+	spin_unlock(&(handle_info->lock));
+
+	if (ret != SPCI_SUCCESS) {
+		SMC_RET1(handle, ret);
+	}
+
+	/*
+	 * The translation tables of a partition are only updated while it
+	 * isn't running, so that it never sees a mapping being replaced. No
+	 * lock is held while waiting for it to be idle.
+	 */
+	if (handle_info->ring_map_sp_ctx != NULL) {
+		sp_context_t *old_sp_ctx = handle_info->ring_map_sp_ctx;
+		size_t old_max_size;
+		uintptr_t old_va = spci_ring_va(old_sp_ctx, index,
+						&old_max_size);
+
+		sp_state_wait_switch(old_sp_ctx, SP_STATE_IDLE, SP_STATE_BUSY);
+		if (spm_sp_unmap_client_mem(old_sp_ctx, old_va,
+					    handle_info->ring_map_size) != 0) {
+			ERROR("SPCI: Can't unmap ring at 0x%lx\n", old_va);
+			panic();
+		}
+		sp_state_set(old_sp_ctx, SP_STATE_IDLE);
+
+		handle_info->ring_map_sp_ctx = NULL;
+		handle_info->ring_map_size = 0U;
+	}
+
+	sp_state_wait_switch(sp_ctx, SP_STATE_IDLE, SP_STATE_BUSY);
+	if (spm_sp_map_client_mem(sp_ctx, ring_va, ring_pa, ring_size) != 0) {
+		ret = SPCI_NO_MEMORY;
+	}
+	sp_state_set(sp_ctx, SP_STATE_IDLE);
+
+	spin_lock(&(handle_info->lock));
+	if (ret == SPCI_SUCCESS) {
+		handle_info->ring_map_sp_ctx = sp_ctx;
+		handle_info->ring_map_size = ring_size;
+		handle_info->ring_size = ring_size;
+	}
+	handle_info->ring_updating = false;
+	spin_unlock(&(handle_info->lock));
+
+	if (ret == SPCI_SUCCESS) {
+		VERBOSE("SPCI: Ring 0x%llx of handle 0x%04x mapped at 0x%lx\n",
+			ring_pa, service_handle, ring_va);
+	}
+
+	SMC_RET1(handle, ret);
+}
+
+/*******************************************************************************
+ * This function notifies the Secure Partition that provides the service of a
+ * handle that there are new requests in its ring, and gives it CPU time if it
+ * is idle. Requests and responses aren't copied by SPM, and any number of them
+ * can be passed with one notification.
+ ******************************************************************************/
+static uint64_t spci_service_ring_doorbell(void *handle, u_register_t x7)
+{
+	spci_handle_t *handle_info;
+	sp_context_t *sp_ctx;
+	uintptr_t ring_va;
+	size_t ring_size, max_size;
+	uint16_t client_id = x7 & 0x0000FFFFU;
+	uint16_t service_handle = (x7 >> 16) & 0x0000FFFFU;
+
+	handle_info = spci_handle_info_get(service_handle, client_id);
+	if (handle_info == NULL) {
+		SMC_RET1(handle, SPCI_INVALID_PARAMETER);
+	}
+
+	sp_ctx = handle_info->sp_ctx;
+	ring_size = handle_info->ring_size;
+	ring_va = spci_ring_va(sp_ctx, handle_info - spci_handles, &max_size);
+
+	spin_unlock(&(handle_info->lock));
+
+	if (ring_size == 0U) {
+		SMC_RET1(handle, SPCI_INVALID_PARAMETER);
+	}
+
+	struct sprt_queue_entry_message message = {
+		.type = SPRT_MSG_TYPE_SERVICE_RING_DOORBELL,
+		.client_id = client_id,
+		.service_handle = service_handle,
+		.session_id = 0,
+		.token = 0,
+		.args = {ring_va, ring_size}
+	};
+
+	spin_lock(&(sp_ctx->spm_sp_buffer_lock));
+	int rc = sprt_push_message((void *)sp_ctx->spm_sp_buffer_base, &message,
+				   SPRT_QUEUE_NUM_NON_BLOCKING);
+	spin_unlock(&(sp_ctx->spm_sp_buffer_lock));
+	if (rc != 0) {
+		SMC_RET1(handle, SPCI_BUSY);
+	}
+
+	/* Try to enter the partition. If it's not possible, simply return. */
+	if (sp_state_try_switch(sp_ctx, SP_STATE_IDLE, SP_STATE_BUSY) != 0) {
+		SMC_RET1(handle, SPCI_SUCCESS);
+	}
+
+	/* Save the Normal world context */
+	cm_el1_sysregs_context_save(NON_SECURE);
+
+	/* Jump to the Secure Partition. */
+	uint64_t ret = spm_sp_synchronous_entry(sp_ctx, 1);
+
+	/* Handle returned values */
+	spci_handle_returned_values(&(sp_ctx->cpu_ctx), ret);
+
+	/* Flag Secure Partition as idle. */
+	assert(sp_ctx->state == SP_STATE_BUSY);
+	sp_state_set(sp_ctx, SP_STATE_IDLE);
+
+	/* Restore non-secure state */
+	cm_el1_sysregs_context_restore(NON_SECURE);
+	cm_set_next_eret_context(NON_SECURE);
+
+	SMC_RET1(handle, SPCI_SUCCESS);
+}
+
+/*******************************************************************************
+ * This function asks the Secure Partition that provides the service of a handle
+ * to process all the requests in its ring, and waits for it to do so. This
+ * amortizes the cost of entering the partition over all the requests. The
+ * partition writes the responses to the ring, and returns the number of
+ * requests it has processed in x1.
+ ******************************************************************************/
+static uint64_t spci_service_ring_request_blocking(void *handle,
+						   u_register_t x7)
+{
+	spci_handle_t *handle_info;
+	size_t max_size;
+	uint16_t client_id = x7 & 0x0000FFFFU;
+	uint16_t service_handle = (x7 >> 16) & 0x0000FFFFU;
+
+	handle_info = spci_handle_info_get(service_handle, client_id);
+	if (handle_info == NULL) {
+		SMC_RET1(handle, SPCI_INVALID_PARAMETER);
+	}
+
+	if (handle_info->ring_size == 0U) {
+		spin_unlock(&(handle_info->lock));
+
+		SMC_RET1(handle, SPCI_INVALID_PARAMETER);
+	}
+
+	struct sprt_queue_entry_message message = {
+		.type = SPRT_MSG_TYPE_SERVICE_RING_REQUEST,
+		.client_id = client_id,
+		.service_handle = service_handle,
+		.session_id = 0,
+		.token = 0,
+		.args = {spci_ring_va(handle_info->sp_ctx,
+				      handle_info - spci_handles, &max_size),
+			 handle_info->ring_size}
+	};
+
+	return spci_request_blocking(handle, handle_info, &message);
+}
+
 /*******************************************************************************
  * This function handles all SMCs in the range reserved for SPCI.
  ******************************************************************************/
@@ -731,6 +1031,31 @@ static uintptr_t spci_smc_handler(uint32_t smc_fid, u_register_t x1,
 			return spci_service_get_response(handle, x1, x7);
 		}
 
+		case SPCI_FID_SERVICE_RING_REGISTER:
+		{
+			uint64_t x7 = SMC_GET_GP(handle, CTX_GPREG_X7);
+
+			if (smc_fid != SPCI_SERVICE_RING_REGISTER_AARCH64) {
+				break;
+			}
+
+			return spci_service_ring_register(handle, x1, x2, x7);
+		}
+
+		case SPCI_FID_SERVICE_RING_DOORBELL:
+		{
+			uint64_t x7 = SMC_GET_GP(handle, CTX_GPREG_X7);
+
+			return spci_service_ring_doorbell(handle, x7);
+		}
+
+		case SPCI_FID_SERVICE_RING_REQUEST_BLOCKING:
+		{
+			uint64_t x7 = SMC_GET_GP(handle, CTX_GPREG_X7);
+
+			return spci_service_ring_request_blocking(handle, x7);
+		}
+
 		default:
 			break;
 		}
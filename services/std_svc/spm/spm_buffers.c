@@ -5,6 +5,7 @@
  */
 
 #include <arch_helpers.h>
+#include <lib/cassert.h>
 #include <lib/spinlock.h>
 #include <lib/utils_def.h>
 #include <platform_def.h>
@@ -12,10 +13,30 @@
 #include "./spm_private.h"
 
 /*******************************************************************************
- * Secure Service response global array. All the responses to the requests done
- * to the Secure Partition are stored here. They are removed from the array as
- * soon as their value is read.
+ * Secure Service responses. All the responses to the requests done to the
+ * Secure Partition are stored here. They are removed as soon as their value is
+ * read.
+ *
+ * Responses are hashed by token into buckets, each with its own lock, so that
+ * requests with different tokens don't contend with each other and only a few
+ * entries are scanned. A response whose bucket is full is stored in the
+ * overflow array instead, and its bucket counts it so that lookups only search
+ * the overflow array when needed. All the responses with a given token are
+ * either in its bucket or in the overflow array, and are only ever accessed
+ * with the lock of the bucket held. The lock of the overflow array is always
+ * taken after the lock of a bucket.
  ******************************************************************************/
+#ifndef PLAT_SPM_RESPONSE_BUCKETS
+#define PLAT_SPM_RESPONSE_BUCKETS	U(8)
+#endif
+
+#ifndef PLAT_SPM_RESPONSE_BUCKET_SLOTS
+#define PLAT_SPM_RESPONSE_BUCKET_SLOTS	U(4)
+#endif
+
+CASSERT((PLAT_SPM_RESPONSE_BUCKETS & (PLAT_SPM_RESPONSE_BUCKETS - 1U)) == 0U,
+	assert_spm_response_buckets_not_power_of_2);
+
 struct sprt_response {
 	int is_valid;
 	uint32_t token;
@@ -23,90 +44,195 @@ struct sprt_response {
 	u_register_t x1, x2, x3;
 };
 
-static struct sprt_response responses[PLAT_SPM_RESPONSES_MAX];
+struct sprt_response_bucket {
+	spinlock_t lock;
+	/* Number of responses of this bucket stored in the overflow array */
+	unsigned int overflow;
+	struct sprt_response slots[PLAT_SPM_RESPONSE_BUCKET_SLOTS];
+} __aligned(CACHE_WRITEBACK_GRANULE);
+
+static struct sprt_response_bucket buckets[PLAT_SPM_RESPONSE_BUCKETS];
+
+/*
+ * The overflow array can hold as many responses as the previous global array,
+ * so PLAT_SPM_RESPONSES_MAX responses can always be stored whatever their
+ * tokens are.
+ */
+static struct sprt_response overflow[PLAT_SPM_RESPONSES_MAX];
+
+static spinlock_t overflow_lock;
+
+static struct sprt_response_bucket *spm_response_bucket(uint32_t token)
+{
+	/* Fibonacci hashing, so that consecutive tokens are spread out */
+	uint32_t hash = token * U(0x9E3779B1);
+
+	return &buckets[(hash >> 16) & (PLAT_SPM_RESPONSE_BUCKETS - 1U)];
+}
+
+static void spm_response_fill(struct sprt_response *resp, uint16_t client_id,
+			      uint16_t handle, uint32_t token, u_register_t x1,
+			      u_register_t x2, u_register_t x3)
+{
+	resp->token = token;
+	resp->client_id = client_id;
+	resp->handle = handle;
+	resp->x1 = x1;
+	resp->x2 = x2;
+	resp->x3 = x3;
 
-static spinlock_t responses_lock;
+	dmbish();
 
-/* Add response to the global response buffer. Returns 0 on success else -1. */
+	resp->is_valid = 1;
+}
+
+/*
+ * Look for a response with the given token in an array. Returns the index of
+ * the response, or -1 if there isn't any. If 'free_idx' isn't NULL, it is set
+ * to the index of a free entry, or -1 if there isn't any.
+ */
+static int spm_response_find(const struct sprt_response *resp,
+			     unsigned int count, uint32_t token,
+			     int *free_idx)
+{
+	if (free_idx != NULL) {
+		*free_idx = -1;
+	}
+
+	for (unsigned int i = 0U; i < count; i++) {
+		if (resp[i].is_valid == 0) {
+			if ((free_idx != NULL) && (*free_idx < 0)) {
+				*free_idx = (int)i;
+			}
+			continue;
+		}
+
+		if (resp[i].token == token) {
+			return (int)i;
+		}
+	}
+
+	return -1;
+}
+
+/* Add a response to the response buffers. Returns 0 on success else -1. */
 int spm_response_add(uint16_t client_id, uint16_t handle, uint32_t token,
 		     u_register_t x1, u_register_t x2, u_register_t x3)
 {
-	spin_lock(&responses_lock);
+	struct sprt_response_bucket *bucket = spm_response_bucket(token);
+	int free_idx, ret = -1;
+
+	spin_lock(&bucket->lock);
 
 	/* Make sure that there isn't any other response with the same token. */
-	for (unsigned int i = 0U; i < ARRAY_SIZE(responses); i++) {
-		struct sprt_response *resp = &(responses[i]);
+	if (spm_response_find(bucket->slots, ARRAY_SIZE(bucket->slots), token,
+			      &free_idx) >= 0) {
+		goto exit;
+	}
+
+	if ((bucket->overflow == 0U) && (free_idx >= 0)) {
+		spm_response_fill(&bucket->slots[free_idx], client_id, handle,
+				  token, x1, x2, x3);
+		ret = 0;
+		goto exit;
+	}
+
+	spin_lock(&overflow_lock);
 
-		if ((resp->is_valid == 1) && (resp->token == token)) {
-			spin_unlock(&responses_lock);
+	if ((bucket->overflow != 0U) &&
+	    (spm_response_find(overflow, ARRAY_SIZE(overflow), token,
+			       NULL) >= 0)) {
+		spin_unlock(&overflow_lock);
+		goto exit;
+	}
+
+	/* Use the overflow array only if the bucket is full */
+	if (free_idx >= 0) {
+		spin_unlock(&overflow_lock);
+		spm_response_fill(&bucket->slots[free_idx], client_id, handle,
+				  token, x1, x2, x3);
+		ret = 0;
+		goto exit;
+	}
 
-			return -1;
+	for (unsigned int i = 0U; i < ARRAY_SIZE(overflow); i++) {
+		if (overflow[i].is_valid == 0) {
+			spm_response_fill(&overflow[i], client_id, handle,
+					  token, x1, x2, x3);
+			bucket->overflow++;
+			ret = 0;
+			break;
 		}
 	}
 
-	for (unsigned int i = 0U; i < ARRAY_SIZE(responses); i++) {
-		struct sprt_response *resp = &(responses[i]);
+	spin_unlock(&overflow_lock);
 
-		if (resp->is_valid == 0) {
-			resp->token = token;
-			resp->client_id = client_id;
-			resp->handle = handle;
-			resp->x1 = x1;
-			resp->x2 = x2;
-			resp->x3 = x3;
+exit:
+	spin_unlock(&bucket->lock);
 
-			dmbish();
+	return ret;
+}
 
-			resp->is_valid = 1;
+/*
+ * Take the response with the given token out of an array if the rest of the
+ * information matches the stored one. Returns 0 on success, -1 if it wasn't
+ * found.
+ */
+static int spm_response_take(struct sprt_response *resp, unsigned int count,
+			     uint16_t client_id, uint16_t handle,
+			     uint32_t token, u_register_t *x1,
+			     u_register_t *x2, u_register_t *x3)
+{
+	int i = spm_response_find(resp, count, token, NULL);
 
-			spin_unlock(&responses_lock);
+	if (i < 0) {
+		return -1;
+	}
 
-			return 0;
-		}
+	/* Make sure that all the information matches the stored one */
+	if ((resp[i].client_id != client_id) || (resp[i].handle != handle)) {
+		return -1;
 	}
 
-	spin_unlock(&responses_lock);
+	*x1 = resp[i].x1;
+	*x2 = resp[i].x2;
+	*x3 = resp[i].x3;
 
-	return -1;
+	dmbish();
+
+	resp[i].is_valid = 0;
+
+	return 0;
 }
 
 /*
- * Returns a response from the requests array and removes it from it. Returns 0
- * on success, -1 if it wasn't found.
+ * Returns a response from the response buffers and removes it from them.
+ * Returns 0 on success, -1 if it wasn't found.
  */
 int spm_response_get(uint16_t client_id, uint16_t handle, uint32_t token,
 		     u_register_t *x1, u_register_t *x2, u_register_t *x3)
 {
-	spin_lock(&responses_lock);
-
-	for (unsigned int i = 0U; i < ARRAY_SIZE(responses); i++) {
-		struct sprt_response *resp = &(responses[i]);
-
-		/* Ignore invalid entries */
-		if (resp->is_valid == 0) {
-			continue;
-		}
+	struct sprt_response_bucket *bucket = spm_response_bucket(token);
+	int ret;
 
-		/* Make sure that all the information matches the stored one */
-		if ((resp->token != token) || (resp->client_id != client_id) ||
-		    (resp->handle != handle)) {
-			continue;
-		}
+	spin_lock(&bucket->lock);
 
-		*x1 = resp->x1;
-		*x2 = resp->x2;
-		*x3 = resp->x3;
+	ret = spm_response_take(bucket->slots, ARRAY_SIZE(bucket->slots),
+				client_id, handle, token, x1, x2, x3);
 
-		dmbish();
+	if ((ret != 0) && (bucket->overflow != 0U)) {
+		spin_lock(&overflow_lock);
 
-		resp->is_valid = 0;
-
-		spin_unlock(&responses_lock);
+		ret = spm_response_take(overflow, ARRAY_SIZE(overflow),
+					client_id, handle, token, x1, x2, x3);
+		if (ret == 0) {
+			bucket->overflow--;
+		}
 
-		return 0;
+		spin_unlock(&overflow_lock);
 	}
 
-	spin_unlock(&responses_lock);
+	spin_unlock(&bucket->lock);
 
-	return -1;
+	return ret;
 }
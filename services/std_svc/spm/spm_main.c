@@ -14,7 +14,9 @@
 #include <bl31/interrupt_mgmt.h>
 #include <common/debug.h>
 #include <common/runtime_svc.h>
+#include <lib/cassert.h>
 #include <lib/el3_runtime/context_mgmt.h>
+#include <lib/psci/psci_lib.h>
 #include <lib/smccc.h>
 #include <lib/spinlock.h>
 #include <lib/utils.h>
@@ -82,35 +84,80 @@ int spm_sp_request_increase_if_zero(sp_context_t *sp_ctx)
 }
 
 /*******************************************************************************
- * This function returns a pointer to the context of the Secure Partition that
- * handles the service specified by an UUID. It returns NULL if the UUID wasn't
- * found.
+ * Index of the services of all Secure Partitions, hashed by UUID with linear
+ * probing. It is built once during setup and only read afterwards, so lookups
+ * need no lock.
  ******************************************************************************/
-sp_context_t *spm_sp_get_by_uuid(const uint32_t (*svc_uuid)[4])
+#ifndef PLAT_SPM_UUID_INDEX_SIZE
+#define PLAT_SPM_UUID_INDEX_SIZE	U(64)
+#endif
+
+CASSERT((PLAT_SPM_UUID_INDEX_SIZE & (PLAT_SPM_UUID_INDEX_SIZE - 1U)) == 0U,
+	assert_spm_uuid_index_size_not_power_of_2);
+CASSERT(PLAT_SPM_UUID_INDEX_SIZE > PLAT_SPM_SERVICES_MAX,
+	assert_spm_uuid_index_size_too_small);
+
+struct spm_uuid_index_entry {
+	const uint32_t *uuid;
+	sp_context_t *sp_ctx;
+};
+
+static struct spm_uuid_index_entry spm_uuid_index[PLAT_SPM_UUID_INDEX_SIZE];
+
+static unsigned int spm_uuid_hash(const uint32_t *uuid)
 {
-	unsigned int i;
+	uint32_t hash = uuid[0] ^ uuid[1] ^ uuid[2] ^ uuid[3];
 
-	for (i = 0U; i < PLAT_SPM_MAX_PARTITIONS; i++) {
+	/* Fibonacci hashing, to use the high bits of the product */
+	hash *= U(0x9E3779B1);
 
-		sp_context_t *sp_ctx = &sp_ctx_array[i];
+	return (hash >> 16) & (PLAT_SPM_UUID_INDEX_SIZE - 1U);
+}
 
-		if (sp_ctx->is_present == 0) {
-			continue;
-		}
+/*
+ * Returns the entry of the index for the given UUID, or the free entry where
+ * it would be added if it isn't present.
+ */
+static struct spm_uuid_index_entry *spm_uuid_index_find(const uint32_t *uuid)
+{
+	unsigned int i = spm_uuid_hash(uuid);
+	struct spm_uuid_index_entry *entry = &spm_uuid_index[i];
 
-		struct sp_rd_sect_service *rdsvc;
+	while ((entry->uuid != NULL) &&
+	       (memcmp(entry->uuid, uuid, sizeof(uint32_t) * 4U) != 0)) {
+		i = (i + 1U) & (PLAT_SPM_UUID_INDEX_SIZE - 1U);
+		entry = &spm_uuid_index[i];
+	}
 
-		for (rdsvc = sp_ctx->rd.service; rdsvc != NULL;
-		     rdsvc = rdsvc->next) {
-			uint32_t *rd_uuid = (uint32_t *)(rdsvc->uuid);
+	return entry;
+}
 
-			if (memcmp(rd_uuid, svc_uuid, sizeof(*svc_uuid)) == 0) {
-				return sp_ctx;
-			}
+/*
+ * Add the services of a Secure Partition to the index. If several partitions
+ * provide the same service, the first one keeps handling it.
+ */
+static void spm_uuid_index_add(sp_context_t *sp_ctx)
+{
+	struct sp_rd_sect_service *rdsvc;
+	struct spm_uuid_index_entry *entry;
+
+	for (rdsvc = sp_ctx->rd.service; rdsvc != NULL; rdsvc = rdsvc->next) {
+		entry = spm_uuid_index_find(rdsvc->uuid);
+		if (entry->uuid == NULL) {
+			entry->uuid = rdsvc->uuid;
+			entry->sp_ctx = sp_ctx;
 		}
 	}
+}
 
-	return NULL;
+/*******************************************************************************
+ * This function returns a pointer to the context of the Secure Partition that
+ * handles the service specified by an UUID. It returns NULL if the UUID wasn't
+ * found.
+ ******************************************************************************/
+sp_context_t *spm_sp_get_by_uuid(const uint32_t (*svc_uuid)[4])
+{
+	return spm_uuid_index_find(*svc_uuid)->sp_ctx;
 }
 
 /*******************************************************************************
@@ -237,12 +284,146 @@ static uint64_t spm_ns_interrupt_handler(uint32_t id, uint32_t flags,
 	spm_sp_synchronous_exit(SPM_SECURE_PARTITION_PREEMPTED);
 }
 
+/*******************************************************************************
+ * Jump to a Secure Partition for the first time.
+ ******************************************************************************/
+static void spm_sp_init(sp_context_t *ctx)
+{
+	uint64_t rc;
+	unsigned int i = (unsigned int)(ctx - sp_ctx_array);
+
+	INFO("Secure Partition %u init...\n", i);
+
+	rc = spm_sp_synchronous_entry(ctx, 0);
+	if (rc != SPRT_YIELD_AARCH64) {
+		ERROR("Unexpected return value 0x%llx\n", rc);
+		panic();
+	}
+
+	INFO("Secure Partition %u initialized.\n", i);
+}
+
+#if SPM_PARALLEL_INIT
+
+/*******************************************************************************
+ * With SPM_PARALLEL_INIT, the partitions are not initialized by the boot CPU
+ * during cold boot. Each secondary CPU claims the next partition still in reset
+ * state when it is turned on by the normal world, and initializes it once the
+ * PSCI power domain locks have been released, so that they come up
+ * concurrently. Any partition left is initialized by the first CPU that opens a
+ * handle to one of its services. A partition being initialized is busy, so
+ * requests wait for it as they would for any other request in progress.
+ ******************************************************************************/
+
+/* Number of present partitions whose initialization hasn't completed */
+static unsigned int spm_sp_init_pending;
+static spinlock_t spm_sp_init_lock;
+
+/* Partition claimed by each CPU when turned on, to be initialized by it */
+static sp_context_t *spm_sp_init_claimed[PLATFORM_CORE_COUNT];
+
+/*
+ * Claim the initialization of a partition unless another CPU has done it or is
+ * doing it. Returns 0 on success, -1 otherwise.
+ */
+static int spm_sp_init_claim(sp_context_t *ctx)
+{
+	return sp_state_try_switch(ctx, SP_STATE_RESET, SP_STATE_BUSY);
+}
+
+/*
+ * Initialize a partition claimed by this CPU. The Normal world context of the
+ * CPU is preserved across the initialization.
+ */
+static void spm_sp_init_claimed_sp(sp_context_t *ctx)
+{
+	unsigned int pending;
+
+	cm_el1_sysregs_context_save(NON_SECURE);
+
+	spm_sp_init(ctx);
+
+	cm_el1_sysregs_context_restore(NON_SECURE);
+	cm_set_next_eret_context(NON_SECURE);
+
+	sp_state_set(ctx, SP_STATE_IDLE);
+
+	spin_lock(&spm_sp_init_lock);
+	pending = --spm_sp_init_pending;
+	spin_unlock(&spm_sp_init_lock);
+
+	if (pending == 0U) {
+		INFO("All Secure Partitions initialized.\n");
+	}
+}
+
+void spm_sp_init_if_pending(sp_context_t *sp_ctx)
+{
+	if (sp_ctx->state != SP_STATE_RESET) {
+		return;
+	}
+
+	if (spm_sp_init_claim(sp_ctx) == 0) {
+		spm_sp_init_claimed_sp(sp_ctx);
+	}
+}
+
+/*
+ * Called with the power domain locks of the CPU held, so only claim the
+ * partition here.
+ */
+static void spm_svc_on_finish(__unused u_register_t unused)
+{
+	unsigned int linear_id = plat_my_core_pos();
+
+	for (unsigned int i = 0U; i < PLAT_SPM_MAX_PARTITIONS; i++) {
+		if ((sp_ctx_array[i].is_present != 0) &&
+		    (spm_sp_init_claim(&sp_ctx_array[i]) == 0)) {
+			spm_sp_init_claimed[linear_id] = &sp_ctx_array[i];
+			return;
+		}
+	}
+}
+
+static void spm_svc_on_finish_unlocked(void)
+{
+	unsigned int linear_id = plat_my_core_pos();
+	sp_context_t *ctx = spm_sp_init_claimed[linear_id];
+
+	if (ctx != NULL) {
+		spm_sp_init_claimed[linear_id] = NULL;
+		spm_sp_init_claimed_sp(ctx);
+	}
+}
+
+static const spd_pm_ops_t spm_pm = {
+	.svc_on_finish = spm_svc_on_finish,
+	.svc_on_finish_unlocked = spm_svc_on_finish_unlocked,
+};
+
+static int32_t spm_init(void)
+{
+	for (unsigned int i = 0U; i < PLAT_SPM_MAX_PARTITIONS; i++) {
+		if (sp_ctx_array[i].is_present != 0) {
+			spm_sp_init_pending++;
+		}
+	}
+
+	psci_register_spd_pm_hook(&spm_pm);
+
+	INFO("Initialization of %u Secure Partitions deferred.\n",
+	     spm_sp_init_pending);
+
+	return 1;
+}
+
+#else /* SPM_PARALLEL_INIT */
+
 /*******************************************************************************
  * Jump to each Secure Partition for the first time.
  ******************************************************************************/
 static int32_t spm_init(void)
 {
-	uint64_t rc = 0;
 	sp_context_t *ctx;
 
 	for (unsigned int i = 0U; i < PLAT_SPM_MAX_PARTITIONS; i++) {
@@ -253,24 +434,18 @@ static int32_t spm_init(void)
 			continue;
 		}
 
-		INFO("Secure Partition %u init...\n", i);
-
 		ctx->state = SP_STATE_RESET;
 
-		rc = spm_sp_synchronous_entry(ctx, 0);
-		if (rc != SPRT_YIELD_AARCH64) {
-			ERROR("Unexpected return value 0x%llx\n", rc);
-			panic();
-		}
+		spm_sp_init(ctx);
 
 		ctx->state = SP_STATE_IDLE;
-
-		INFO("Secure Partition %u initialized.\n", i);
 	}
 
-	return rc;
+	return SPRT_YIELD_AARCH64;
 }
 
+#endif /* SPM_PARALLEL_INIT */
+
 /*******************************************************************************
  * Initialize contexts of all Secure Partitions.
  ******************************************************************************/
@@ -342,6 +517,8 @@ int32_t spm_setup(void)
 
 		ctx->is_present = 1;
 
+		spm_uuid_index_add(ctx);
+
 		INFO("Secure Partition %u setup done.\n", i);
 
 		i++;
@@ -72,6 +72,10 @@ typedef struct sp_context {
 	uintptr_t spm_sp_buffer_base;
 	size_t spm_sp_buffer_size;
 	spinlock_t spm_sp_buffer_lock;
+
+	/* VA range where the rings registered by clients are mapped */
+	uintptr_t ring_va_base;
+	size_t ring_va_size;
 } sp_context_t;
 
 /* Functions used to enter/exit a Secure Partition synchronously */
@@ -90,6 +94,15 @@ void sp_state_set(sp_context_t *sp_ptr, sp_state_t state);
 void sp_state_wait_switch(sp_context_t *sp_ptr, sp_state_t from, sp_state_t to);
 int sp_state_try_switch(sp_context_t *sp_ptr, sp_state_t from, sp_state_t to);
 
+/* Initialization of a Secure Partition not yet done by any CPU */
+#if SPM_PARALLEL_INIT
+void spm_sp_init_if_pending(sp_context_t *sp_ctx);
+#else
+static inline void spm_sp_init_if_pending(sp_context_t *sp_ctx)
+{
+}
+#endif
+
 /* Functions to keep track of the number of active requests per SP */
 void spm_sp_request_increase(sp_context_t *sp_ctx);
 void spm_sp_request_decrease(sp_context_t *sp_ctx);
@@ -102,6 +115,10 @@ uint64_t *spm_exceptions_xlat_get_base_table(void);
 /* Functions related to the translation tables management */
 void spm_sp_xlat_context_alloc(sp_context_t *sp_ctx);
 void sp_map_memory_regions(sp_context_t *sp_ctx);
+int spm_sp_map_client_mem(sp_context_t *sp_ctx, uintptr_t base_va,
+			  unsigned long long base_pa, size_t size);
+int spm_sp_unmap_client_mem(sp_context_t *sp_ctx, uintptr_t base_va,
+			    size_t size);
 
 /* Functions to handle Secure Partition contexts */
 void spm_cpu_set_sp_ctx(unsigned int linear_id, sp_context_t *sp_ctx);
@@ -182,6 +182,53 @@ static uintptr_t spm_alloc_heap(size_t size)
 	return (uintptr_t)pool_alloc_n(&spm_heap_mem, size);
 }
 
+/* Skipping heap memory to map regions with blocks is opt-in. */
+#ifndef PLAT_SPM_HEAP_BLOCK_ALIGN
+#define PLAT_SPM_HEAP_BLOCK_ALIGN	0
+#endif
+
+/*
+ * Allocate memory for a region mapped at base_va in a partition so that it can
+ * be mapped with the largest blocks possible. The translation tables can only
+ * use a block if the PA and the VA have the same offset into it, so heap memory
+ * is skipped to give the PA the offset of the VA into the largest block that
+ * fits in the region. This is only done if the heap still has enough memory
+ * left for the region and for the 'reserve' bytes needed by the regions of the
+ * partition allocated after it.
+ */
+static uintptr_t spm_alloc_heap_blocks(uintptr_t base_va, size_t size,
+				       size_t reserve)
+{
+	uintptr_t next = PLAT_SPM_HEAP_BASE + spm_heap_mem.used;
+	size_t left = spm_heap_mem.capacity - spm_heap_mem.used;
+	unsigned int level;
+
+	if ((PLAT_SPM_HEAP_BLOCK_ALIGN == 0) || ((size + reserve) > left)) {
+		return spm_alloc_heap(size);
+	}
+
+	/* Memory which can be skipped without starving the next regions */
+	left -= size + reserve;
+
+	for (level = MIN_LVL_BLOCK_DESC; level < XLAT_TABLE_LEVEL_MAX; level++) {
+		uintptr_t block_size = XLAT_BLOCK_SIZE(level);
+		uintptr_t block_va = round_up(base_va, block_size);
+		size_t pad = (base_va - next) & (block_size - 1U);
+
+		if (((block_va + block_size) <= (base_va + size)) &&
+		    (pad <= left)) {
+			if (pad != 0U) {
+				VERBOSE("  Skipping 0x%zx bytes of heap to use 0x%lx blocks\n",
+					pad, block_size);
+				(void) spm_alloc_heap(pad);
+			}
+			break;
+		}
+	}
+
+	return spm_alloc_heap(size);
+}
+
 /*******************************************************************************
  * Functions to map memory regions described in the resource description.
  ******************************************************************************/
@@ -189,7 +236,7 @@ static unsigned int rdmem_attr_to_mmap_attr(uint32_t attr)
 {
 	unsigned int index = attr & RD_MEM_MASK;
 
-	const unsigned int mmap_attr_arr[8] = {
+	const unsigned int mmap_attr_arr[9] = {
 		MT_DEVICE | MT_RW | MT_SECURE,	/* RD_MEM_DEVICE */
 		MT_CODE | MT_SECURE,		/* RD_MEM_NORMAL_CODE */
 		MT_MEMORY | MT_RW | MT_SECURE,	/* RD_MEM_NORMAL_DATA */
@@ -197,7 +244,8 @@ static unsigned int rdmem_attr_to_mmap_attr(uint32_t attr)
 		MT_RO_DATA | MT_SECURE,		/* RD_MEM_NORMAL_RODATA */
 		MT_MEMORY | MT_RW | MT_SECURE,	/* RD_MEM_NORMAL_SPM_SP_SHARED_MEM */
 		MT_MEMORY | MT_RW | MT_SECURE,	/* RD_MEM_NORMAL_CLIENT_SHARED_MEM */
-		MT_MEMORY | MT_RW | MT_SECURE	/* RD_MEM_NORMAL_MISCELLANEOUS */
+		MT_MEMORY | MT_RW | MT_SECURE,	/* RD_MEM_NORMAL_MISCELLANEOUS */
+		MT_MEMORY | MT_RW | MT_NS	/* RD_MEM_NORMAL_CLIENT_RINGS */
 	};
 
 	if (index >= ARRAY_SIZE(mmap_attr_arr)) {
@@ -213,7 +261,8 @@ static unsigned int rdmem_attr_to_mmap_attr(uint32_t attr)
  * compatible with a mmap_region structure. This function handles the conversion
  * and maps it.
  */
-static void map_rdmem(sp_context_t *sp_ctx, struct sp_rd_sect_mem_region *rdmem)
+static void map_rdmem(sp_context_t *sp_ctx, struct sp_rd_sect_mem_region *rdmem,
+		      size_t heap_reserve)
 {
 	int rc;
 	mmap_region_t mmap;
@@ -271,7 +320,8 @@ static void map_rdmem(sp_context_t *sp_ctx, struct sp_rd_sect_mem_region *rdmem)
 			panic();
 		}
 
-		rd_base_pa = spm_alloc_heap(rd_size);
+		rd_base_pa = spm_alloc_heap_blocks(rd_base_va, rd_size,
+						   heap_reserve);
 
 		/* Get offset into the image */
 		void *img_pa = (void *)(sp_base_pa + rd_base_va - sp_base_va);
@@ -311,17 +361,36 @@ static void map_rdmem(sp_context_t *sp_ctx, struct sp_rd_sect_mem_region *rdmem)
 			ERROR("A partition must have only one SPM<->SP buffer.\n");
 			panic();
 		}
-		rd_base_pa = spm_alloc_heap(rd_size);
+		rd_base_pa = spm_alloc_heap_blocks(rd_base_va, rd_size,
+						   heap_reserve);
 		zero_region = 1;
 		/* Save location of this buffer, it is needed by SPM */
 		sp_ctx->spm_sp_buffer_base = rd_base_pa;
 		sp_ctx->spm_sp_buffer_size = rd_size;
 		break;
 
+	case RD_MEM_NORMAL_CLIENT_RINGS:
+		if (sp_ctx->ring_va_size != 0U) {
+			ERROR("Only one client ring region per partition.\n");
+			panic();
+		}
+		if (((rd_base_va | rd_size) & PAGE_SIZE_MASK) != 0U) {
+			ERROR("Client ring region must be page-aligned.\n");
+			panic();
+		}
+		/*
+		 * Only reserve the VA range. The rings registered by clients
+		 * are mapped in it at runtime.
+		 */
+		sp_ctx->ring_va_base = rd_base_va;
+		sp_ctx->ring_va_size = rd_size;
+		return;
+
 	case RD_MEM_NORMAL_CLIENT_SHARED_MEM:
 		/* Fallthrough */
 	case RD_MEM_NORMAL_BSS:
-		rd_base_pa = spm_alloc_heap(rd_size);
+		rd_base_pa = spm_alloc_heap_blocks(rd_base_va, rd_size,
+						   heap_reserve);
 		zero_region = 1;
 		break;
 
@@ -369,13 +438,72 @@ static void map_rdmem(sp_context_t *sp_ctx, struct sp_rd_sect_mem_region *rdmem)
 	}
 }
 
+/* Size of the memory allocated from the heap for a region */
+static size_t rdmem_heap_size(const struct sp_rd_sect_mem_region *rdmem)
+{
+	switch (rdmem->attr & RD_MEM_MASK) {
+	case RD_MEM_NORMAL_DATA:
+	case RD_MEM_NORMAL_BSS:
+	case RD_MEM_NORMAL_SPM_SP_SHARED_MEM:
+	case RD_MEM_NORMAL_CLIENT_SHARED_MEM:
+	case RD_MEM_NORMAL_MISCELLANEOUS:
+		return rdmem->size;
+	default:
+		return 0U;
+	}
+}
+
 void sp_map_memory_regions(sp_context_t *sp_ctx)
 {
 	struct sp_rd_sect_mem_region *rdmem;
+	size_t heap_reserve = 0U;
 
 	for (rdmem = sp_ctx->rd.mem_region; rdmem != NULL; rdmem = rdmem->next) {
-		map_rdmem(sp_ctx, rdmem);
+		heap_reserve += rdmem_heap_size(rdmem);
+	}
+
+	for (rdmem = sp_ctx->rd.mem_region; rdmem != NULL; rdmem = rdmem->next) {
+		/* Heap memory needed by the regions after this one */
+		heap_reserve -= rdmem_heap_size(rdmem);
+
+		map_rdmem(sp_ctx, rdmem, heap_reserve);
 	}
 
 	init_xlat_tables_ctx(sp_ctx->xlat_ctx_handle);
 }
+
+/*******************************************************************************
+ * Functions to map memory shared by clients at runtime. The memory is mapped as
+ * Non-secure, so the partition can't access Secure memory through it whatever
+ * physical address the client provides.
+ ******************************************************************************/
+int spm_sp_map_client_mem(sp_context_t *sp_ctx, uintptr_t base_va,
+			  unsigned long long base_pa, size_t size)
+{
+	int rc;
+	mmap_region_t mmap = MAP_REGION2(base_pa, base_va, size,
+			MT_MEMORY | MT_RW | MT_NS | MT_USER, PAGE_SIZE);
+
+	assert(base_va >= sp_ctx->ring_va_base);
+	assert((base_va + size) <= (sp_ctx->ring_va_base +
+				    sp_ctx->ring_va_size));
+
+	spin_lock(&(sp_ctx->xlat_ctx_lock));
+	rc = mmap_add_dynamic_region_ctx(sp_ctx->xlat_ctx_handle, &mmap);
+	spin_unlock(&(sp_ctx->xlat_ctx_lock));
+
+	return rc;
+}
+
+int spm_sp_unmap_client_mem(sp_context_t *sp_ctx, uintptr_t base_va,
+			    size_t size)
+{
+	int rc;
+
+	spin_lock(&(sp_ctx->xlat_ctx_lock));
+	rc = mmap_remove_dynamic_region_ctx(sp_ctx->xlat_ctx_handle, base_va,
+					    size);
+	spin_unlock(&(sp_ctx->xlat_ctx_lock));
+
+	return rc;
+}
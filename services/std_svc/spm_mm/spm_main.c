@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -7,6 +7,7 @@
 #include <arch_helpers.h>
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 
 #include <bl31/bl31.h>
 #include <bl31/ehf.h>
@@ -26,9 +27,32 @@
 #include "spm_private.h"
 
 /*******************************************************************************
- * Secure Partition context information.
+ * Secure Partition context information. With SPM_MM_MP, each CPU has its own
+ * context and stack in the Secure Partition, so that CPUs can execute in it
+ * concurrently. Otherwise, all CPUs share a single context.
  ******************************************************************************/
-static sp_context_t sp_ctx;
+#if SPM_MM_MP
+#define SP_CTX_COUNT	PLATFORM_CORE_COUNT
+#else
+#define SP_CTX_COUNT	1
+#endif
+
+static sp_context_t sp_ctx[SP_CTX_COUNT];
+
+/* Set once the Secure Partition has been initialised on the primary CPU */
+static bool sp_init_done;
+
+/*******************************************************************************
+ * Return the Secure Partition context used by the calling CPU.
+ ******************************************************************************/
+static sp_context_t *spm_cpu_sp_ctx(void)
+{
+#if SPM_MM_MP
+	return &sp_ctx[plat_my_core_pos()];
+#else
+	return &sp_ctx[0];
+#endif
+}
 
 /*******************************************************************************
  * Set state of a Secure Partition context.
@@ -118,7 +142,7 @@ static uint64_t spm_sp_synchronous_entry(sp_context_t *sp_ctx)
  ******************************************************************************/
 __dead2 static void spm_sp_synchronous_exit(uint64_t rc)
 {
-	sp_context_t *ctx = &sp_ctx;
+	sp_context_t *ctx = spm_cpu_sp_ctx();
 
 	/*
 	 * The SPM must have initiated the original request through a
@@ -140,7 +164,7 @@ static int32_t spm_init(void)
 
 	INFO("Secure Partition init...\n");
 
-	ctx = &sp_ctx;
+	ctx = spm_cpu_sp_ctx();
 
 	ctx->state = SP_STATE_RESET;
 
@@ -148,6 +172,7 @@ static int32_t spm_init(void)
 	assert(rc == 0);
 
 	ctx->state = SP_STATE_IDLE;
+	sp_init_done = true;
 
 	INFO("Secure Partition initialized.\n");
 
@@ -160,6 +185,9 @@ static int32_t spm_init(void)
 int32_t spm_setup(void)
 {
 	sp_context_t *ctx;
+#if SPM_MM_MP
+	unsigned int i;
+#endif
 
 	/* Disable MMU at EL1 (initialized by BL2) */
 	disable_mmu_icache_el1();
@@ -167,13 +195,29 @@ int32_t spm_setup(void)
 	/* Initialize context of the SP */
 	INFO("Secure Partition context setup start...\n");
 
-	ctx = &sp_ctx;
+	ctx = spm_cpu_sp_ctx();
 
 	/* Assign translation tables context. */
 	ctx->xlat_ctx_handle = spm_get_sp_xlat_context();
 
 	spm_sp_setup(ctx);
 
+#if SPM_MM_MP
+	/*
+	 * The contexts of the other CPUs start from the same state, but with
+	 * their own stack. They are initialised by entering the Secure
+	 * Partition on each CPU the first time it is called from it.
+	 */
+	for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		if (&sp_ctx[i] == ctx)
+			continue;
+
+		sp_ctx[i].xlat_ctx_handle = ctx->xlat_ctx_handle;
+		sp_ctx[i].cpu_ctx = ctx->cpu_ctx;
+		spm_sp_setup_cpu(&sp_ctx[i], i);
+	}
+#endif
+
 	/* Register init function for deferred init.  */
 	bl31_register_bl32_init(&spm_init);
 
@@ -188,9 +232,25 @@ int32_t spm_setup(void)
 uint64_t spm_sp_call(uint32_t smc_fid, uint64_t x1, uint64_t x2, uint64_t x3)
 {
 	uint64_t rc;
-	sp_context_t *sp_ptr = &sp_ctx;
+	sp_context_t *sp_ptr = spm_cpu_sp_ctx();
+
+#if SPM_MM_MP
+	/* Initialise the context of this CPU the first time it is used */
+	if (sp_ptr->state == SP_STATE_RESET) {
+		VERBOSE("Secure Partition init on CPU %u\n",
+			plat_my_core_pos());
+
+		rc = spm_sp_synchronous_entry(sp_ptr);
+		assert(rc == 0);
 
-	/* Wait until the Secure Partition is idle and set it to busy. */
+		sp_state_set(sp_ptr, SP_STATE_IDLE);
+	}
+#endif
+
+	/*
+	 * Wait until the Secure Partition is idle and set it to busy. With
+	 * SPM_MM_MP, no other CPU uses this context, so this doesn't wait.
+	 */
 	sp_state_wait_switch(sp_ptr, SP_STATE_IDLE, SP_STATE_BUSY);
 
 	/* Set values for registers on SP entry */
@@ -238,7 +298,8 @@ static uint64_t mm_communicate(uint32_t smc_fid, uint64_t mm_cookie,
 	/*
 	 * The current secure partition design mandates
 	 * - at any point, only a single core can be
-	 *   executing in the secure partiton.
+	 *   executing in the secure partiton, unless
+	 *   SPM_MM_MP gives each core its own context.
 	 * - a core cannot be preempted by an interrupt
 	 *   while executing in secure partition.
 	 * Raise the running priority of the core to the
@@ -304,24 +365,24 @@ uint64_t spm_smc_handler(uint32_t smc_fid,
 		case SP_MEMORY_ATTRIBUTES_GET_AARCH64:
 			INFO("Received SP_MEMORY_ATTRIBUTES_GET_AARCH64 SMC\n");
 
-			if (sp_ctx.state != SP_STATE_RESET) {
+			if (sp_init_done) {
 				WARN("SP_MEMORY_ATTRIBUTES_GET_AARCH64 is available at boot time only\n");
 				SMC_RET1(handle, SPM_NOT_SUPPORTED);
 			}
 			SMC_RET1(handle,
 				 spm_memory_attributes_get_smc_handler(
-					 &sp_ctx, x1));
+					 spm_cpu_sp_ctx(), x1));
 
 		case SP_MEMORY_ATTRIBUTES_SET_AARCH64:
 			INFO("Received SP_MEMORY_ATTRIBUTES_SET_AARCH64 SMC\n");
 
-			if (sp_ctx.state != SP_STATE_RESET) {
+			if (sp_init_done) {
 				WARN("SP_MEMORY_ATTRIBUTES_SET_AARCH64 is available at boot time only\n");
 				SMC_RET1(handle, SPM_NOT_SUPPORTED);
 			}
 			SMC_RET1(handle,
 				 spm_memory_attributes_set_smc_handler(
-					&sp_ctx, x1, x2, x3));
+					spm_cpu_sp_ctx(), x1, x2, x3));
 		default:
 			break;
 		}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -21,6 +21,29 @@
 #include "spm_private.h"
 #include "spm_shim_private.h"
 
+#if SPM_MM_MP
+/*
+ * Setup the registers of the context of the Secure Partition which differ
+ * between CPUs. The rest of the context is the one set up by spm_sp_setup().
+ */
+void spm_sp_setup_cpu(sp_context_t *sp_ctx, unsigned int linear_id)
+{
+	cpu_context_t *ctx = &(sp_ctx->cpu_ctx);
+
+	assert(linear_id < PLATFORM_CORE_COUNT);
+
+	/* SP_EL0: Top of the stack of this CPU in the SP image. */
+	write_ctx_reg(get_gpregs_ctx(ctx), CTX_GPREG_SP_EL0,
+		      PLAT_SP_IMAGE_STACK_BASE +
+		      ((linear_id + 1U) * PLAT_SP_IMAGE_STACK_PCPU_SIZE));
+
+	/* X4: Linear index of this CPU, as in the MP information. */
+	write_ctx_reg(get_gpregs_ctx(ctx), CTX_GPREG_X4, linear_id);
+
+	sp_ctx->state = SP_STATE_RESET;
+}
+#endif /* SPM_MM_MP */
+
 /* Setup context of the Secure Partition */
 void spm_sp_setup(sp_context_t *sp_ctx)
 {
@@ -60,6 +83,9 @@ void spm_sp_setup(sp_context_t *sp_ctx)
 
 	cm_setup_context(ctx, &ep_info);
 
+#if SPM_MM_MP
+	spm_sp_setup_cpu(sp_ctx, plat_my_core_pos());
+#else
 	/*
 	 * SP_EL0: A non-zero value will indicate to the SP that the SPM has
 	 * initialized the stack pointer for the current CPU through
@@ -67,6 +93,7 @@ void spm_sp_setup(sp_context_t *sp_ctx)
 	 */
 	write_ctx_reg(get_gpregs_ctx(ctx), CTX_GPREG_SP_EL0,
 			PLAT_SP_IMAGE_STACK_BASE + PLAT_SP_IMAGE_STACK_PCPU_SIZE);
+#endif
 
 	/*
 	 * Setup translation tables
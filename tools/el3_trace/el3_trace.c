@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2019, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Decoder for the EL3 event trace. It reads the records gathered from BL31 by
+ * a Normal world agent, in any order and from any number of CPUs, and prints
+ * them as a single timeline.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "el3_trace.h"
+
+/* Fields of an SMC Function ID */
+#define FUNCID_TYPE_SHIFT	31
+#define FUNCID_CC_SHIFT		30
+#define FUNCID_OEN_SHIFT	24
+#define FUNCID_OEN_MASK		0x3f
+#define FUNCID_NUM_MASK		0xffff
+
+/* Maximum number of CPUs whose SMCs are matched with their return */
+#define MAX_CPUS		1024
+
+static struct el3_trace_record *records;
+static size_t num_records;
+
+/* Counter frequency in Hz, or 0 to print ticks */
+static uint64_t cntfrq;
+
+/* Timestamp of the SMC in progress on each CPU */
+static uint64_t smc_start[MAX_CPUS];
+
+static void load_records(const char *path)
+{
+	FILE *fp;
+	long size;
+
+	fp = fopen(path, "rb");
+	if (fp == NULL) {
+		fprintf(stderr, "error: %s couldn't be opened.\n", path);
+		exit(1);
+	}
+
+	if ((fseek(fp, 0L, SEEK_END) != 0) || ((size = ftell(fp)) < 0) ||
+	    (fseek(fp, 0L, SEEK_SET) != 0)) {
+		fprintf(stderr, "error: Couldn't get the size of %s\n", path);
+		exit(1);
+	}
+
+	if ((size % sizeof(struct el3_trace_record)) != 0) {
+		fprintf(stderr, "error: Size of %s is not a multiple of %zu\n",
+			path, sizeof(struct el3_trace_record));
+		exit(1);
+	}
+
+	num_records = (size_t)size / sizeof(struct el3_trace_record);
+	records = malloc((num_records == 0U) ? 1U : (size_t)size);
+	if (records == NULL) {
+		fprintf(stderr, "error: Not enough memory to load %s\n", path);
+		exit(1);
+	}
+
+	if (fread(records, sizeof(struct el3_trace_record), num_records, fp) !=
+	    num_records) {
+		fprintf(stderr, "error: Couldn't read %s\n", path);
+		exit(1);
+	}
+
+	fclose(fp);
+}
+
+/* Order the records by timestamp, then by CPU and index in its ring */
+static int compare_records(const void *a, const void *b)
+{
+	const struct el3_trace_record *ra = a, *rb = b;
+
+	if (ra->timestamp != rb->timestamp)
+		return (ra->timestamp < rb->timestamp) ? -1 : 1;
+	if (ra->cpu != rb->cpu)
+		return (ra->cpu < rb->cpu) ? -1 : 1;
+	if (ra->seq != rb->seq)
+		return (ra->seq < rb->seq) ? -1 : 1;
+	return 0;
+}
+
+static const char *oen_name(uint64_t fid)
+{
+	static const char * const names[] = {
+		"Arm", "CPU", "SiP", "OEM", "Std", "Std Hyp", "Vendor EL3"
+	};
+	unsigned int oen = (fid >> FUNCID_OEN_SHIFT) & FUNCID_OEN_MASK;
+
+	if (oen < (sizeof(names) / sizeof(names[0])))
+		return names[oen];
+	if ((oen >= 48U) && (oen <= 49U))
+		return "Trusted App";
+	if ((oen >= 50U) && (oen <= 63U))
+		return "Trusted OS";
+	return "Reserved";
+}
+
+static const char *security_state_name(uint64_t state)
+{
+	return (state == 0U) ? "Secure" : "Non-secure";
+}
+
+static const char *intr_type_name(uint64_t type)
+{
+	static const char * const names[] = { "S-EL1", "EL3", "NS" };
+
+	return (type < 3U) ? names[type] : "Invalid";
+}
+
+static const char *psci_name(uint64_t transition)
+{
+	static const char * const names[] = {
+		"suspend", "off", "on finish", "suspend finish"
+	};
+
+	return (transition < 4U) ? names[transition] : "unknown";
+}
+
+static void print_ticks(uint64_t ticks)
+{
+	if (cntfrq == 0U)
+		printf("%" PRIu64 " ticks", ticks);
+	else
+		printf("%.3f us", (double)ticks * 1e6 / (double)cntfrq);
+}
+
+static void print_record(const struct el3_trace_record *rec, uint64_t t0)
+{
+	uint64_t fid = rec->arg0;
+
+	if (cntfrq == 0U)
+		printf("%14" PRIu64 "  ", rec->timestamp - t0);
+	else
+		printf("%14.3f  ", (double)(rec->timestamp - t0) * 1e6 /
+		       (double)cntfrq);
+
+	printf("cpu%-4u ", rec->cpu);
+
+	switch (rec->event) {
+	case EL3_TRACE_EV_SMC_ENTRY:
+		if (rec->cpu < MAX_CPUS)
+			smc_start[rec->cpu] = rec->timestamp;
+		printf("SMC    0x%08" PRIx64 " (%s %s %s #%" PRIu64
+		       ") x1=0x%" PRIx64 "\n", fid,
+		       (((fid >> FUNCID_TYPE_SHIFT) & 1U) != 0U) ?
+				"fast" : "yielding",
+		       (((fid >> FUNCID_CC_SHIFT) & 1U) != 0U) ?
+				"SMC64" : "SMC32",
+		       oen_name(fid), fid & FUNCID_NUM_MASK, rec->arg1);
+		break;
+	case EL3_TRACE_EV_SMC_EXIT:
+		printf("RET    0x%08" PRIx64, fid);
+		if ((rec->cpu < MAX_CPUS) && (smc_start[rec->cpu] != 0U)) {
+			printf(" after ");
+			print_ticks(rec->timestamp - smc_start[rec->cpu]);
+			smc_start[rec->cpu] = 0U;
+		}
+		printf("\n");
+		break;
+	case EL3_TRACE_EV_INTR:
+		printf("IRQ    %s interrupt %" PRIu64 "\n",
+		       intr_type_name(rec->arg0), rec->arg1);
+		break;
+	case EL3_TRACE_EV_WORLD_SWITCH:
+		printf("SWITCH %s -> %s\n", security_state_name(rec->arg1),
+		       security_state_name(rec->arg0));
+		break;
+	case EL3_TRACE_EV_PSCI:
+		printf("PSCI   %s, power level %" PRIu64 "\n",
+		       psci_name(rec->arg0), rec->arg1);
+		break;
+	case EL3_TRACE_EV_SDEI_DISPATCH:
+		printf("SDEI   event %" PRId64 " (interrupt %" PRIu64 ")\n",
+		       (int64_t)rec->arg0, rec->arg1);
+		break;
+	default:
+		printf("?      event %u 0x%" PRIx64 " 0x%" PRIx64 "\n",
+		       rec->event, rec->arg0, rec->arg1);
+		break;
+	}
+}
+
+static void usage(void)
+{
+	printf("usage: el3_trace ");
+#ifdef VERSION
+	printf(VERSION);
+#else
+	/* If built from el3_trace directory, VERSION is not set. */
+	printf("version unknown");
+#endif
+	printf(" [<args>] <trace file>\n\n");
+
+	printf("This tool decodes the records of the BL31 event trace read with\n"
+	       "the ARM_SIP_SVC_EL3_TRACE_READ SMC, and prints them as a single\n"
+	       "timeline across all CPUs.\n\n");
+	printf("Commands supported:\n");
+	printf("  -f <freq>            Counter frequency in Hz (CNTFRQ_EL0), to\n"
+	       "                       print times in microseconds.\n");
+	printf("  -h                   Show this message.\n");
+	exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+	int ch;
+	size_t i;
+
+	while ((ch = getopt(argc, argv, "hf:")) != -1) {
+		switch (ch) {
+		case 'f':
+			cntfrq = strtoull(optarg, NULL, 0);
+			break;
+		case 'h':
+		default:
+			usage();
+		}
+	}
+
+	argc -= optind;
+	argv += optind;
+
+	if (argc != 1) {
+		fprintf(stderr, "error: A trace file must be provided.\n\n");
+		usage();
+	}
+
+	load_records(argv[0]);
+
+	qsort(records, num_records, sizeof(struct el3_trace_record),
+	      compare_records);
+
+	for (i = 0U; i < num_records; i++) {
+		if (records[i].event != EL3_TRACE_EV_NONE)
+			print_record(&records[i], records[0].timestamp);
+	}
+
+	free(records);
+
+	return 0;
+}
@@ -0,0 +1,509 @@
+/*
+ * Copyright (c) 2019, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Formats the log messages output by images built with LOG_TOKENIZED=1. Each
+ * of these messages is a line "$<image id>:<base64 payload>", where the payload
+ * holds the address of the format string in the .tf_log_fmt section of the ELF
+ * file of the image, and then the arguments of the message. Other lines are
+ * printed as they are.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Maximum number of images whose ELF file can be given */
+#define MAX_IMAGES		8
+
+/* Maximum length of a line of the log */
+#define MAX_LINE		4096
+
+/* Same values as the LOG_LEVEL_* macros of include/common/debug.h */
+#define LOG_LEVEL_ERROR		10
+#define LOG_LEVEL_VERBOSE	50
+
+struct image {
+	unsigned int id;
+	/* Address and contents of the .tf_log_fmt section */
+	uint64_t fmt_addr;
+	char *fmt;
+	size_t fmt_size;
+	/* Size of long in the image, in bytes */
+	unsigned int long_size;
+};
+
+static struct image images[MAX_IMAGES];
+static unsigned int num_images;
+
+static const char * const prefix_str[] = {
+	"ERROR:   ", "NOTICE:  ", "WARNING: ", "INFO:    ", "VERBOSE: "
+};
+
+static uint64_t read_le(const unsigned char *p, unsigned int size)
+{
+	uint64_t val = 0U;
+
+	while (size-- > 0U)
+		val = (val << 8) | p[size];
+
+	return val;
+}
+
+static unsigned char *load_file(const char *path, size_t *size)
+{
+	FILE *fp;
+	long len;
+	unsigned char *buf;
+
+	fp = fopen(path, "rb");
+	if (fp == NULL) {
+		fprintf(stderr, "error: %s couldn't be opened.\n", path);
+		exit(1);
+	}
+
+	if ((fseek(fp, 0L, SEEK_END) != 0) || ((len = ftell(fp)) < 0) ||
+	    (fseek(fp, 0L, SEEK_SET) != 0)) {
+		fprintf(stderr, "error: Couldn't get the size of %s\n", path);
+		exit(1);
+	}
+
+	buf = malloc((len == 0) ? 1U : (size_t)len);
+	if (buf == NULL) {
+		fprintf(stderr, "error: Not enough memory to load %s\n", path);
+		exit(1);
+	}
+
+	if (fread(buf, 1U, (size_t)len, fp) != (size_t)len) {
+		fprintf(stderr, "error: Couldn't read %s\n", path);
+		exit(1);
+	}
+
+	fclose(fp);
+
+	*size = (size_t)len;
+	return buf;
+}
+
+/* Find the .tf_log_fmt section of a little-endian ELF file */
+static void load_image(unsigned int id, const char *path)
+{
+	struct image *img;
+	unsigned char *elf;
+	const unsigned char *sh, *strtab_sh;
+	size_t size;
+	uint64_t shoff, strtab_off, name, off, len;
+	unsigned int is_64, shentsize, shnum, shstrndx, i;
+
+	if (num_images == MAX_IMAGES) {
+		fprintf(stderr, "error: Too many ELF files.\n");
+		exit(1);
+	}
+
+	elf = load_file(path, &size);
+
+	if ((size < 52U) || (memcmp(elf, "\177ELF", 4U) != 0) ||
+	    (elf[5] != 1U)) {
+		fprintf(stderr, "error: %s isn't a little-endian ELF file.\n",
+			path);
+		exit(1);
+	}
+
+	is_64 = (elf[4] == 2U) ? 1U : 0U;
+	if (is_64 != 0U) {
+		if (size < 64U) {
+			fprintf(stderr, "error: %s is truncated.\n", path);
+			exit(1);
+		}
+		shoff = read_le(&elf[40], 8U);
+		shentsize = (unsigned int)read_le(&elf[58], 2U);
+		shnum = (unsigned int)read_le(&elf[60], 2U);
+		shstrndx = (unsigned int)read_le(&elf[62], 2U);
+	} else {
+		shoff = read_le(&elf[32], 4U);
+		shentsize = (unsigned int)read_le(&elf[46], 2U);
+		shnum = (unsigned int)read_le(&elf[48], 2U);
+		shstrndx = (unsigned int)read_le(&elf[50], 2U);
+	}
+
+	if ((shstrndx >= shnum) || (shentsize < (is_64 ? 64U : 40U)) ||
+	    (shoff > size) ||
+	    (((uint64_t)shnum * shentsize) > (size - shoff))) {
+		fprintf(stderr, "error: Invalid section headers in %s\n", path);
+		exit(1);
+	}
+
+	strtab_sh = &elf[shoff + (uint64_t)shstrndx * shentsize];
+	strtab_off = is_64 ? read_le(&strtab_sh[24], 8U) :
+			     read_le(&strtab_sh[16], 4U);
+
+	img = &images[num_images];
+	img->id = id;
+	img->long_size = is_64 ? 8U : 4U;
+
+	for (i = 0U; i < shnum; i++) {
+		sh = &elf[shoff + (uint64_t)i * shentsize];
+		name = strtab_off + read_le(&sh[0], 4U);
+		if ((name >= size) ||
+		    (strncmp((const char *)&elf[name], ".tf_log_fmt",
+			     size - name) != 0))
+			continue;
+
+		img->fmt_addr = is_64 ? read_le(&sh[16], 8U) :
+					read_le(&sh[12], 4U);
+		off = is_64 ? read_le(&sh[24], 8U) : read_le(&sh[16], 4U);
+		len = is_64 ? read_le(&sh[32], 8U) : read_le(&sh[20], 4U);
+		if ((off > size) || (len > (size - off))) {
+			fprintf(stderr, "error: Invalid .tf_log_fmt in %s\n",
+				path);
+			exit(1);
+		}
+
+		img->fmt = malloc((len == 0U) ? 1U : (size_t)len);
+		if (img->fmt == NULL) {
+			fprintf(stderr, "error: Not enough memory\n");
+			exit(1);
+		}
+		memcpy(img->fmt, &elf[off], (size_t)len);
+		img->fmt_size = (size_t)len;
+		break;
+	}
+
+	free(elf);
+
+	if (img->fmt == NULL) {
+		fprintf(stderr, "error: %s has no .tf_log_fmt section. Was it "
+			"built with LOG_TOKENIZED=1?\n", path);
+		exit(1);
+	}
+
+	num_images++;
+}
+
+static struct image *find_image(unsigned int id)
+{
+	unsigned int i;
+
+	for (i = 0U; i < num_images; i++) {
+		if (images[i].id == id)
+			return &images[i];
+	}
+
+	return NULL;
+}
+
+/* Returns the size of the decoded payload, or -1 if it isn't valid base64 */
+static int decode_base64(const char *in, unsigned char *out, size_t out_size)
+{
+	static const char b64[] =
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+		"abcdefghijklmnopqrstuvwxyz"
+		"0123456789+/";
+	const char *c;
+	uint32_t val = 0U;
+	unsigned int bits = 0U;
+	size_t len = 0U;
+
+	for (; (*in != '\0') && (*in != '='); in++) {
+		c = strchr(b64, *in);
+		if (c == NULL)
+			return -1;
+
+		val = (val << 6) | (uint32_t)(c - b64);
+		bits += 6U;
+		if (bits >= 8U) {
+			bits -= 8U;
+			if (len == out_size)
+				return -1;
+			out[len++] = (unsigned char)(val >> bits);
+		}
+	}
+
+	return (int)len;
+}
+
+struct payload {
+	const unsigned char *buf;
+	size_t len;
+	size_t pos;
+};
+
+/* Returns 0 if the payload holds no more argument */
+static int get_varint(struct payload *p, uint64_t *val)
+{
+	unsigned int shift = 0U;
+
+	*val = 0U;
+	while ((p->pos < p->len) && (shift < 64U)) {
+		*val |= (uint64_t)(p->buf[p->pos] & 0x7fU) << shift;
+		shift += 7U;
+		if ((p->buf[p->pos++] & 0x80U) == 0U)
+			return 1;
+	}
+
+	return 0;
+}
+
+static void print_num(uint64_t unum, unsigned int radix, char padc, int padn)
+{
+	char num_buf[20];
+	int i = 0;
+
+	do {
+		num_buf[i++] = "0123456789abcdef"[unum % radix];
+		unum /= radix;
+	} while (unum != 0U);
+
+	if (padn > 0) {
+		while (i < padn--)
+			putchar(padc);
+	}
+
+	while (--i >= 0)
+		putchar(num_buf[i]);
+}
+
+/*
+ * Format a message like the printf() of TF-A, with the arguments taken from
+ * the payload. Returns -1 if the payload doesn't match the format string.
+ */
+static int print_message(const struct image *img, const char *fmt,
+			 struct payload *p)
+{
+	unsigned int l_count, size;
+	uint64_t val;
+	char padc;
+	int padn;
+
+	for (; *fmt != '\0'; fmt++) {
+		if (*fmt != '%') {
+			putchar(*fmt);
+			continue;
+		}
+
+		l_count = 0U;
+		padc = '\0';
+		padn = 0;
+		fmt++;
+
+		if (*fmt == '0') {
+			padc = '0';
+			for (fmt++; (*fmt >= '0') && (*fmt <= '9'); fmt++)
+				padn = (padn * 10) + (*fmt - '0');
+		}
+
+		for (; (*fmt == 'l') || (*fmt == 'z'); fmt++) {
+			if (*fmt == 'z')
+				l_count = (img->long_size == 8U) ? 2U : 0U;
+			else
+				l_count++;
+		}
+
+		if (*fmt == 's') {
+			if (p->pos >= p->len)
+				return -1;
+			while ((p->pos < p->len) && (p->buf[p->pos] != 0U))
+				putchar(p->buf[p->pos++]);
+			p->pos++;
+			continue;
+		}
+
+		if (get_varint(p, &val) == 0)
+			return -1;
+
+		/* Size in bytes of the argument */
+		if (l_count == 0U)
+			size = 4U;
+		else if (l_count == 1U)
+			size = img->long_size;
+		else
+			size = 8U;
+
+		switch (*fmt) {
+		case 'i':
+		case 'd':
+			if ((size == 4U) && ((val & 0x80000000U) != 0U))
+				val |= ~(uint64_t)0xffffffffU;
+			if ((int64_t)val < 0) {
+				putchar('-');
+				val = (uint64_t)-(int64_t)val;
+				padn--;
+			}
+			print_num(val, 10U, padc, padn);
+			break;
+		case 'p':
+			if (val > 0U) {
+				printf("0x");
+				padn -= 2;
+			}
+			print_num(val, 16U, padc, padn);
+			break;
+		case 'x':
+			if (size == 4U)
+				val &= 0xffffffffU;
+			print_num(val, 16U, padc, padn);
+			break;
+		case 'u':
+			if (size == 4U)
+				val &= 0xffffffffU;
+			print_num(val, 10U, padc, padn);
+			break;
+		default:
+			/* printf() stops on any other format specifier */
+			return 0;
+		}
+	}
+
+	return 0;
+}
+
+/* Returns -1 if the line isn't a valid tokenized message */
+static int print_tokenized(const char *line, const char *frame)
+{
+	unsigned char buf[MAX_LINE];
+	struct payload p;
+	struct image *img;
+	uint64_t token;
+	char *end;
+	unsigned long id;
+	int len;
+	unsigned int level;
+
+	id = strtoul(frame + 1, &end, 10);
+	if ((end == (frame + 1)) || (*end != ':'))
+		return -1;
+
+	img = find_image((unsigned int)id);
+	if (img == NULL)
+		return -1;
+
+	len = decode_base64(end + 1, buf, sizeof(buf));
+	if (len < 0)
+		return -1;
+
+	p.buf = buf;
+	p.len = (size_t)len;
+	p.pos = 0U;
+
+	if (get_varint(&p, &token) == 0)
+		return -1;
+
+	/* The token is the address of the format string */
+	token -= img->fmt_addr;
+	if (token >= img->fmt_size)
+		return -1;
+
+	/* Print what precedes the message on the line */
+	fwrite(line, 1U, (size_t)(frame - line), stdout);
+
+	/* The first character of the format string is its LOG_MARKER_* */
+	level = (unsigned char)img->fmt[token];
+	if (level < LOG_LEVEL_ERROR)
+		level = LOG_LEVEL_ERROR;
+	else if (level > LOG_LEVEL_VERBOSE)
+		level = LOG_LEVEL_VERBOSE;
+	printf("%s", prefix_str[(level / 10U) - 1U]);
+
+	if (print_message(img, &img->fmt[token + 1U], &p) != 0)
+		printf(" <missing arguments>\n");
+
+	return 0;
+}
+
+static void detokenize(FILE *fp)
+{
+	char line[MAX_LINE];
+	char *frame, *end;
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		frame = strchr(line, '$');
+		if (frame != NULL) {
+			end = &frame[strcspn(frame, "\r\n")];
+			*end = '\0';
+			if (print_tokenized(line, frame) == 0)
+				continue;
+			*end = '\n';
+			end[1] = '\0';
+		}
+		fputs(line, stdout);
+	}
+}
+
+static void usage(void)
+{
+	printf("usage: log_detokenize ");
+#ifdef VERSION
+	printf(VERSION);
+#else
+	/* If built from log_detokenize directory, VERSION is not set. */
+	printf("version unknown");
+#endif
+	printf(" [<args>] [<log file>]\n\n");
+
+	printf("This tool formats the log messages of images built with\n"
+	       "LOG_TOKENIZED=1, read from the log file or from the standard\n"
+	       "input.\n\n");
+	printf("Commands supported:\n");
+	printf("  -e <id>=<elf>        ELF file of the image with the given\n"
+	       "                       identifier: 1 for BL1, 2 for BL2, 21\n"
+	       "                       for BL2U, 31 for BL31, 32 for BL32.\n");
+	printf("  -h                   Show this message.\n");
+	exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+	FILE *fp = stdin;
+	char *end;
+	unsigned long id;
+	int ch;
+
+	while ((ch = getopt(argc, argv, "he:")) != -1) {
+		switch (ch) {
+		case 'e':
+			id = strtoul(optarg, &end, 10);
+			if ((end == optarg) || (*end != '=')) {
+				fprintf(stderr, "error: Invalid ELF file "
+					"argument %s\n\n", optarg);
+				usage();
+			}
+			load_image((unsigned int)id, end + 1);
+			break;
+		case 'h':
+		default:
+			usage();
+		}
+	}
+
+	argc -= optind;
+	argv += optind;
+
+	if (num_images == 0U) {
+		fprintf(stderr, "error: An ELF file must be provided.\n\n");
+		usage();
+	}
+
+	if (argc > 1)
+		usage();
+
+	if (argc == 1) {
+		fp = fopen(argv[0], "r");
+		if (fp == NULL) {
+			fprintf(stderr, "error: %s couldn't be opened.\n",
+				argv[0]);
+			exit(1);
+		}
+	}
+
+	detokenize(fp);
+
+	if (fp != stdin)
+		fclose(fp);
+
+	return 0;
+}